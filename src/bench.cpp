@@ -0,0 +1,473 @@
+// Copyright (c) 1981-86 Robert A. Koeneke
+// Copyright (c) 1987-94 James E. Wilson
+//
+// This work is free software released under the GNU General Public License
+// version 2.0, and comes with ABSOLUTELY NO WARRANTY.
+//
+// See LICENSE and AUTHORS for more information.
+
+// Benchmarks of the game's hot spots, timed over fixed seeds
+
+#include "headers.h"
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <vector>
+
+static const char *usage_instructions = R"(
+Usage:
+    umoria_bench [OPTIONS] [BENCHMARK...]
+
+Runs each BENCHMARK whose name starts with one of the given names (default:
+all of them), and prints a latency histogram for each.
+
+Options:
+    -s NUMBER    Seed to start from (default: 1)
+    -n NUMBER    Number of samples, or seeds, for each benchmark (default: 20)
+    -l           List the benchmarks and exit
+    -h           Display this message
+)";
+
+// The timings of one benchmark, each sample is the time taken by
+// `ops_per_sample` operations, and is stored per operation.
+typedef struct {
+    std::string name;
+    int ops_per_sample;
+    std::vector<uint64_t> samples;
+} Benchmark_t;
+
+typedef struct {
+    const char *name;
+    void (*run)(uint32_t seed, int samples);
+} BenchmarkEntry_t;
+
+// a deque, so the benchmarks being timed are not moved by adding more
+static std::deque<Benchmark_t> results;
+
+// The character is made by answering the character creation prompts
+// with these keys, after which every prompt is answered with ESCAPE.
+static const char *bench_keys = "am\033aBench\r ";
+
+static int benchReadKey() {
+    if (*bench_keys != '\0') {
+        return (uint8_t) *bench_keys++;
+    }
+    return ESCAPE;
+}
+
+static bool benchKeyPressWaiting() {
+    return false;
+}
+
+static const KeySource_t bench_key_source = {benchReadKey, benchKeyPressWaiting, true};
+
+static uint64_t benchNow() {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static Benchmark_t &benchStart(std::string const &name, int ops_per_sample) {
+    results.push_back(Benchmark_t{name, ops_per_sample, std::vector<uint64_t>()});
+    return results.back();
+}
+
+static void benchRecord(Benchmark_t &bench, uint64_t start) {
+    uint64_t elapsed = benchNow() - start;
+    bench.samples.push_back(elapsed / (uint64_t) bench.ops_per_sample);
+}
+
+// Keeps the player alive through any amount of monster attacks and
+// area spells, which would otherwise end the benchmark early.
+static void benchRevivePlayer() {
+    py.misc.current_hp = 30000;
+    py.misc.current_hp_fraction = 0;
+    game.character_is_dead = false;
+}
+
+static void benchGenerateLevel(int level, uint32_t level_seed) {
+    dg.current_level = (int16_t) level;
+    game.level_seed = level_seed;
+    generateCave();
+}
+
+// A level with up to `count` extra monsters, awake and within sight range
+// of the player, so that every one of them gets its moves. There may be
+// fewer, when there are not that many free floor tiles in range.
+static void benchGenerateDenseLevel(int level, uint32_t level_seed, int count) {
+    benchGenerateLevel(level, level_seed);
+
+    int const range = config::monsters::MON_MAX_SIGHT;
+    std::vector<Coord_t> free_tiles;
+
+    for (int y = py.pos.y - range; y <= py.pos.y + range; y++) {
+        for (int x = py.pos.x - range; x <= py.pos.x + range; x++) {
+            Coord_t coord = Coord_t{y, x};
+
+            if (coordInBounds(coord) &&                                      //
+                dg.floor[y][x].feature_id <= MAX_OPEN_SPACE &&               //
+                dg.floor[y][x].creature_id == 0 &&                           //
+                coordDistanceBetween(py.pos, coord) > 1 &&                   //
+                coordDistanceBetween(py.pos, coord) <= range) {
+                free_tiles.push_back(coord);
+            }
+        }
+    }
+
+    int highest = std::min(level, (int) MON_MAX_LEVELS);
+
+    for (int i = 0; i < count && !free_tiles.empty(); i++) {
+        int pick = randomNumber((int) free_tiles.size()) - 1;
+        Coord_t coord = free_tiles[pick];
+        free_tiles[pick] = free_tiles.back();
+        free_tiles.pop_back();
+
+        (void) monsterPlaceNew(coord, randomNumber(monster_levels[highest]) - 1, false);
+    }
+
+    benchRevivePlayer();
+}
+
+static void benchGenerateCave(uint32_t seed, int samples) {
+    typedef struct {
+        int lowest;
+        int highest;
+    } DepthBand_t;
+
+    DepthBand_t const bands[] = {{0, 0}, {1, 9}, {10, 19}, {20, 29}, {30, 39}, {40, 49}, {50, 99}};
+
+    for (auto const &band : bands) {
+        std::string name = "generateCave depth " + std::to_string(band.lowest);
+        if (band.highest != band.lowest) {
+            name += "-" + std::to_string(band.highest);
+        }
+        Benchmark_t &bench = benchStart(name, 1);
+
+        for (int i = 0; i < samples; i++) {
+            int level = band.lowest + i % (band.highest - band.lowest + 1);
+
+            dg.current_level = (int16_t) level;
+            game.level_seed = seed + (uint32_t) i;
+
+            uint64_t start = benchNow();
+            generateCave();
+            benchRecord(bench, start);
+        }
+    }
+}
+
+static void benchUpdateMonsters(uint32_t seed, int samples) {
+    int const levels[] = {10, 30, 50};
+    int const turns = 10;
+
+    for (auto level : levels) {
+        Benchmark_t &bench = benchStart("updateMonsters dense depth " + std::to_string(level), 1);
+
+        for (int i = 0; i < samples; i++) {
+            benchGenerateDenseLevel(level, seed + (uint32_t) i, 300);
+
+            for (int turn = 0; turn < turns; turn++) {
+                uint64_t start = benchNow();
+                updateMonsters(true);
+                benchRecord(bench, start);
+
+                benchRevivePlayer();
+            }
+        }
+    }
+}
+
+static void benchLineOfSight(uint32_t seed, int samples) {
+    int const ops = 1000;
+    Benchmark_t &bench = benchStart("los", ops);
+
+    Coord_t from[ops];
+    Coord_t to[ops];
+
+    for (int i = 0; i < samples; i++) {
+        benchGenerateLevel(10 + i % 40, seed + (uint32_t) i);
+
+        // pairs no further apart than the player can see
+        for (int op = 0; op < ops; op++) {
+            from[op].y = randomNumber(dg.height - 2);
+            from[op].x = randomNumber(dg.width - 2);
+            to[op].y = std::max(1, std::min(dg.height - 2, from[op].y + randomNumber(2 * config::monsters::MON_MAX_SIGHT + 1) - config::monsters::MON_MAX_SIGHT - 1));
+            to[op].x = std::max(1, std::min(dg.width - 2, from[op].x + randomNumber(2 * config::monsters::MON_MAX_SIGHT + 1) - config::monsters::MON_MAX_SIGHT - 1));
+        }
+
+        int visible = 0;
+
+        uint64_t start = benchNow();
+        for (int op = 0; op < ops; op++) {
+            if (los(from[op], to[op])) {
+                visible++;
+            }
+        }
+        benchRecord(bench, start);
+
+        // keeps the calls from being optimised away
+        if (visible > ops) {
+            abort();
+        }
+    }
+}
+
+static void benchAreaSpells(uint32_t seed, int samples) {
+    int const casts = 8;
+
+    Benchmark_t &fire_ball = benchStart("spellFireBall", 1);
+    Benchmark_t &breath = benchStart("spellBreath", 1);
+
+    for (int i = 0; i < samples; i++) {
+        benchGenerateDenseLevel(30, seed + (uint32_t) i, 300);
+
+        for (int cast = 0; cast < casts; cast++) {
+            // the eight directions around the player, skipping 5
+            int direction = cast < 4 ? cast + 1 : cast + 2;
+
+            uint64_t start = benchNow();
+            spellFireBall(py.pos, direction, 72, MagicSpellFlags::Fire, "Fire Ball");
+            benchRecord(fire_ball, start);
+
+            benchRevivePlayer();
+        }
+
+        for (int cast = 0; cast < casts; cast++) {
+            int monster_id = next_free_monster_id - 1;
+            while (monster_id >= config::monsters::MON_MIN_INDEX_ID && !monsterIsAllocated(monster_id)) {
+                monster_id--;
+            }
+            if (monster_id < config::monsters::MON_MIN_INDEX_ID) {
+                break;
+            }
+
+            uint64_t start = benchNow();
+            spellBreath(py.pos, monster_id, 100, MagicSpellFlags::Frost, "the bench dragon");
+            benchRecord(breath, start);
+
+            benchRevivePlayer();
+        }
+    }
+}
+
+static void benchSaveAndLoad(uint32_t seed, int samples) {
+    Benchmark_t &save = benchStart("saveGame", 1);
+    Benchmark_t &load = benchStart("loadGame", 1);
+
+    std::string const save_game = config::files::save_game;
+    config::files::save_game = "umoria_bench_" + std::to_string(getpid()) + ".sav";
+
+    for (int i = 0; i < samples; i++) {
+        benchGenerateDenseLevel(10 + i % 40, seed + (uint32_t) i, 100);
+
+        (void) unlink(config::files::save_game.c_str());
+        game.character_saved = false;
+
+        uint64_t start = benchNow();
+        bool saved = saveGame();
+        benchRecord(save, start);
+
+        if (!saved) {
+            break;
+        }
+
+        bool generate = false;
+
+        start = benchNow();
+        bool loaded = loadGame(generate);
+        benchRecord(load, start);
+
+        if (!loaded) {
+            break;
+        }
+    }
+
+    (void) unlink(config::files::save_game.c_str());
+    config::files::save_game = save_game;
+}
+
+static void benchItemDescription(uint32_t seed, int samples) {
+    (void) seed;
+
+    int const ops = 10;
+
+    Benchmark_t &unknown = benchStart("itemDescription unidentified", ops);
+    Benchmark_t &known = benchStart("itemDescription identified", ops);
+
+    obj_desc_t description = {'\0'};
+    Inventory_t item{};
+
+    for (int i = 0; i < samples; i++) {
+        for (int id = 0; id < MAX_OBJECTS_IN_GAME; id++) {
+            inventoryItemCopyTo(id, item);
+            item.items_count = (uint8_t)(1 + i % 3);
+
+            uint64_t start = benchNow();
+            for (int op = 0; op < ops; op++) {
+                itemDescription(description, item, true);
+            }
+            benchRecord(unknown, start);
+
+            itemIdentifyAsStoreBought(item);
+            itemSetAsIdentified(item.category_id, item.sub_category_id);
+
+            start = benchNow();
+            for (int op = 0; op < ops; op++) {
+                itemDescription(description, item, true);
+            }
+            benchRecord(known, start);
+        }
+    }
+}
+
+static BenchmarkEntry_t const benchmarks[] = {
+    {"generateCave", benchGenerateCave},
+    {"updateMonsters", benchUpdateMonsters},
+    {"los", benchLineOfSight},
+    {"spell", benchAreaSpells},
+    {"saveGame", benchSaveAndLoad},
+    {"itemDescription", benchItemDescription},
+};
+
+static std::string benchFormatDuration(uint64_t ns) {
+    char text[32];
+
+    if (ns < 1000) {
+        (void) sprintf(text, "%u ns", (unsigned int) ns);
+    } else if (ns < 1000000) {
+        (void) sprintf(text, "%.1f us", (double) ns / 1e3);
+    } else {
+        (void) sprintf(text, "%.2f ms", (double) ns / 1e6);
+    }
+
+    return text;
+}
+
+static int benchHistogramBucket(uint64_t ns) {
+    int bucket = 0;
+    while (ns > 1) {
+        ns >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+// Prints the percentiles of a benchmark, and a histogram of its
+// samples in power of two buckets.
+static void benchReport(Benchmark_t &bench) {
+    if (bench.samples.empty()) {
+        printf("%-32s no samples\n\n", bench.name.c_str());
+        return;
+    }
+
+    std::vector<uint64_t> &samples = bench.samples;
+    std::sort(samples.begin(), samples.end());
+
+    uint64_t total = 0;
+    for (auto sample : samples) {
+        total += sample;
+    }
+
+    auto percentile = [&samples](int p) { return samples[(samples.size() - 1) * (size_t) p / 100]; };
+
+    printf("%-32s %6d samples  mean %s  p50 %s  p90 %s  p99 %s  max %s\n",
+           bench.name.c_str(),
+           (int) samples.size(),
+           benchFormatDuration(total / samples.size()).c_str(),
+           benchFormatDuration(percentile(50)).c_str(),
+           benchFormatDuration(percentile(90)).c_str(),
+           benchFormatDuration(percentile(99)).c_str(),
+           benchFormatDuration(samples.back()).c_str());
+
+    int lowest = benchHistogramBucket(samples.front());
+    int highest = benchHistogramBucket(samples.back());
+
+    std::vector<int> counts((size_t)(highest - lowest + 1), 0);
+    for (auto sample : samples) {
+        counts[(size_t)(benchHistogramBucket(sample) - lowest)]++;
+    }
+    int most = *std::max_element(counts.begin(), counts.end());
+
+    for (int bucket = lowest; bucket <= highest; bucket++) {
+        int count = counts[(size_t)(bucket - lowest)];
+        int bar = (count * 40 + most - 1) / most;
+
+        printf("    %10s - %-10s %-40s %d\n", benchFormatDuration((uint64_t) 1 << bucket).c_str(), benchFormatDuration((uint64_t) 1 << (bucket + 1)).c_str(), std::string((size_t) bar, '#').c_str(), count);
+    }
+    printf("\n");
+}
+
+static bool benchSelected(const char *name, int argc, char *argv[], int first) {
+    if (first == argc) {
+        return true;
+    }
+    for (int i = first; i < argc; i++) {
+        if (strncmp(name, argv[i], strlen(argv[i])) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Sets up a new character just as startMoria() does.
+static void benchCreateCharacter(uint32_t seed) {
+    gameInitialize(seed);
+    gameCreateCharacter();
+    magicInitializeItemNames();
+
+    // the first turn of playDungeon(), without which a save file
+    // is taken to be of a game that was never started
+    dg.game_turn = 0;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t seed = 1;
+    int samples = 20;
+
+    int first = 1;
+    for (; first < argc && argv[first][0] == '-'; first++) {
+        switch (argv[first][1]) {
+            case 's':
+                if (first + 1 == argc || (seed = (uint32_t) strtoul(argv[first + 1], nullptr, 10)) == 0) {
+                    printf("%s", usage_instructions);
+                    return 1;
+                }
+                first++;
+                break;
+            case 'n':
+                if (first + 1 == argc || (samples = atoi(argv[first + 1])) < 1) {
+                    printf("%s", usage_instructions);
+                    return 1;
+                }
+                first++;
+                break;
+            case 'l':
+                for (auto const &entry : benchmarks) {
+                    printf("%s\n", entry.name);
+                }
+                return 0;
+            case 'h':
+            default:
+                printf("%s", usage_instructions);
+                return 0;
+        }
+    }
+
+    terminalInitializeNullUI(bench_key_source);
+
+    benchCreateCharacter(seed);
+
+    for (auto const &entry : benchmarks) {
+        if (!benchSelected(entry.name, argc, argv, first)) {
+            continue;
+        }
+
+        size_t first_result = results.size();
+        entry.run(seed, samples);
+
+        for (size_t i = first_result; i < results.size(); i++) {
+            benchReport(results[i]);
+        }
+        (void) fflush(stdout);
+    }
+
+    return 0;
+}
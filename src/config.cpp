@@ -40,6 +40,7 @@ namespace config {
         bool use_roguelike_keys = false;     // Use classic Roguelike keys
         bool show_inventory_weights = false; // Display weights in inventory
         bool error_beep_sound = true;        // Beep for invalid characters
+        bool animate_projectiles = true;     // Show bolts, balls and thrown objects in flight
     } // namespace options
 
     // Dungeon generation values
@@ -159,6 +160,7 @@ namespace config {
         const uint8_t MON_CHANCE_OF_NEW = 160;            // 1/x chance of new monster each round
         const uint8_t MON_MAX_SIGHT = 20;                 // Maximum dis a creature can be seen
         const uint8_t MON_MAX_SPELL_CAST_DISTANCE = 20;   // Maximum dis creature spell can be cast
+        const uint8_t MON_MAX_FLOW_DISTANCE = 20;         // Maximum dis creature follows flow map to player
         const uint8_t MON_MAX_MULTIPLY_PER_LEVEL = 75;    // Maximum reproductions on a level
         const uint8_t MON_MULTIPLY_ADJUST = 7;            // High value slows multiplication
         const uint8_t MON_CHANCE_OF_NASTY = 50;           // 1/x chance of high level creature
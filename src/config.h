@@ -38,6 +38,7 @@ namespace config {
         extern bool use_roguelike_keys;
         extern bool show_inventory_weights;
         extern bool error_beep_sound;
+        extern bool animate_projectiles;
     }
 
     namespace dungeon {
@@ -149,6 +150,7 @@ namespace config {
         extern const uint8_t MON_CHANCE_OF_NEW;
         extern const uint8_t MON_MAX_SIGHT;
         extern const uint8_t MON_MAX_SPELL_CAST_DISTANCE;
+        extern const uint8_t MON_MAX_FLOW_DISTANCE;
         extern const uint8_t MON_MAX_MULTIPLY_PER_LEVEL;
         extern const uint8_t MON_MULTIPLY_ADJUST;
         extern const uint8_t MON_CHANCE_OF_NASTY;
@@ -10,9 +10,13 @@
 
 // generates damage for 2d6 style dice rolls
 int diceRoll(Dice_t const &dice) {
+    // the same numbers as a randomNumber() for each die, drawn in one batch
+    int32_t rolls[UINT8_MAX];
+    rndFill(rolls, dice.dice);
+
     auto sum = 0;
     for (auto i = 0; i < dice.dice; i++) {
-        sum += randomNumber(dice.sides);
+        sum += (rolls[i] % dice.sides) + 1;
     }
     return sum;
 }
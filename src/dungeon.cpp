@@ -98,6 +98,80 @@ void dungeonDisplayMap() {
     terminalRestoreScreen();
 }
 
+// Recalculate the opacity bitplanes from the feature_id plane
+void DungeonFloor_t::rebuildOpacity() {
+    opacity_changes++;
+
+    memset(opaque_rows, 0, sizeof(opaque_rows));
+    memset(opaque_columns, 0, sizeof(opaque_columns));
+
+    for (int y = 0; y < MAX_HEIGHT; y++) {
+        for (int x = 0; x < MAX_WIDTH; x++) {
+            if (feature_id[y][x] >= MIN_CLOSED_SPACE) {
+                opaque_rows[y][x >> 6] |= planeBitMask(x);
+                opaque_columns[x][y >> 6] |= planeBitMask(y);
+            }
+        }
+    }
+}
+
+// Recalculate the bounds of each block's room from the perma_lit_room plane
+void DungeonFloor_t::rebuildRooms() {
+    for (auto &block_row : rooms) {
+        for (auto &room : block_row) {
+            room = Room_t{Coord_t{MAX_HEIGHT, MAX_WIDTH}, Coord_t{-1, -1}};
+        }
+    }
+
+    for (int y = 0; y < MAX_HEIGHT; y++) {
+        for (int word = 0; word < TILE_PLANE_WORDS; word++) {
+            if (perma_lit_room[y][word] == 0) {
+                continue;
+            }
+
+            for (int x = word << 6; x < (word << 6) + 64 && x < MAX_WIDTH; x++) {
+                if ((perma_lit_room[y][word] & planeBitMask(x)) == 0) {
+                    continue;
+                }
+
+                Room_t &room = rooms[y / ROOM_BLOCK_HEIGHT][x / ROOM_BLOCK_WIDTH];
+                room.top_left.y = std::min(room.top_left.y, y);
+                room.top_left.x = std::min(room.top_left.x, x);
+                room.bottom_right.y = std::max(room.bottom_right.y, y);
+                room.bottom_right.x = std::max(room.bottom_right.x, x);
+            }
+        }
+    }
+}
+
+// Shrinks the box from `top_left` to `bottom_right` down to the bounds of
+// the rooms it overlaps, returning false if no room tiles are left in it.
+bool dungeonRoomTilesWithin(Coord_t &top_left, Coord_t &bottom_right) {
+    Coord_t first = Coord_t{MAX_HEIGHT, MAX_WIDTH};
+    Coord_t last = Coord_t{-1, -1};
+
+    int bottom_block = std::min(bottom_right.y / ROOM_BLOCK_HEIGHT, ROOM_BLOCK_ROWS - 1);
+    int right_block = std::min(bottom_right.x / ROOM_BLOCK_WIDTH, ROOM_BLOCK_COLUMNS - 1);
+
+    for (int block_y = top_left.y / ROOM_BLOCK_HEIGHT; block_y <= bottom_block; block_y++) {
+        for (int block_x = top_left.x / ROOM_BLOCK_WIDTH; block_x <= right_block; block_x++) {
+            Room_t const &room = dg.floor.rooms[block_y][block_x];
+
+            first.y = std::min(first.y, room.top_left.y);
+            first.x = std::min(first.x, room.top_left.x);
+            last.y = std::max(last.y, room.bottom_right.y);
+            last.x = std::max(last.x, room.bottom_right.x);
+        }
+    }
+
+    top_left.y = std::max(top_left.y, first.y);
+    top_left.x = std::max(top_left.x, first.x);
+    bottom_right.y = std::min(bottom_right.y, last.y);
+    bottom_right.x = std::min(bottom_right.x, last.x);
+
+    return top_left.y <= bottom_right.y && top_left.x <= bottom_right.x;
+}
+
 // Checks a co-ordinate for in bounds status -RAK-
 bool coordInBounds(Coord_t const &coord) {
     bool y = coord.y > 0 && coord.y < dg.height - 1;
@@ -353,27 +427,51 @@ void dungeonPlaceRandomObjectNear(Coord_t coord, int tries) {
 // this always works correctly, even if y1==y2 and x1==x2
 void dungeonMoveCreatureRecord(Coord_t const &from, Coord_t const &to) {
     int id = dg.floor[from.y][from.x].creature_id;
+    if (id >= config::monsters::MON_MIN_INDEX_ID) {
+        monsterIndexMove(id, to);
+        monsterScheduleWake(id);
+    }
     dg.floor[from.y][from.x].creature_id = 0;
-    dg.floor[to.y][to.x].creature_id = (uint8_t) id;
+    dg.floor[to.y][to.x].creature_id = (uint16_t) id;
 }
 
 // Room is lit, make it appear -RAK-
+//
+// Only the room tiles of the block which are still dark need any work.
+// They are looked for within the bounds of the block's room, and a
+// bitplane word at a time.
 void dungeonLightRoom(Coord_t const &coord) {
-    int height_middle = (SCREEN_HEIGHT / 2);
-    int width_middle = (SCREEN_WIDTH / 2);
+    Coord_t top_left = Coord_t{(coord.y / ROOM_BLOCK_HEIGHT) * ROOM_BLOCK_HEIGHT, (coord.x / ROOM_BLOCK_WIDTH) * ROOM_BLOCK_WIDTH};
+    Coord_t bottom_right = Coord_t{top_left.y + ROOM_BLOCK_HEIGHT - 1, top_left.x + ROOM_BLOCK_WIDTH - 1};
 
-    int top = (coord.y / height_middle) * height_middle;
-    int left = (coord.x / width_middle) * width_middle;
-    int bottom = top + height_middle - 1;
-    int right = left + width_middle - 1;
+    if (!dungeonRoomTilesWithin(top_left, bottom_right)) {
+        return;
+    }
+
+    int top = top_left.y;
+    int left = top_left.x;
+    int bottom = bottom_right.y;
+    int right = bottom_right.x;
 
     Coord_t location = Coord_t{0, 0};
 
     for (location.y = top; location.y <= bottom; location.y++) {
-        for (location.x = left; location.x <= right; location.x++) {
-            Tile_t &tile = dg.floor[location.y][location.x];
+        for (int word = left >> 6; word <= right >> 6; word++) {
+            uint64_t dark = dg.floor.perma_lit_room[location.y][word] & ~dg.floor.permanent_light[location.y][word];
+            if (dark == 0) {
+                continue;
+            }
+
+            int first = word == left >> 6 ? left : word << 6;
+            int last = word == right >> 6 ? right : (word << 6) + 63;
+
+            for (location.x = first; location.x <= last; location.x++) {
+                if ((dark & DungeonFloor_t::planeBitMask(location.x)) == 0) {
+                    continue;
+                }
+
+                Tile_t tile = dg.floor[location.y][location.x];
 
-            if (tile.perma_lit_room && !tile.permanent_light) {
                 tile.permanent_light = true;
 
                 if (tile.feature_id == TILE_DARK_FLOOR) {
@@ -401,9 +499,45 @@ void dungeonLiteSpot(Coord_t const &coord) {
     panelPutTile(symbol, coord);
 }
 
+// The light flags of a tile, which moving the character's light may change.
+static int tileLightFlags(Tile_t const &tile) {
+    return (tile.temporary_light ? 1 : 0) | (tile.permanent_light ? 2 : 0) | (tile.field_mark ? 4 : 0);
+}
+
+// A tile about the player, and its light flags from before the light moved.
+typedef struct {
+    Coord_t coord;
+    int light_flags;
+} LightTile_t;
+
 // Normal movement
 // When FIND_FLAG,  light only permanent features
+//
+// Only the tiles lit before or after the move are looked at, and of those
+// only the ones whose light changed, and the two the player moved between,
+// are drawn again. This relies on everything else that changes the light of
+// a tile, such as darkening, earthquakes and tunnelling, drawing that tile
+// again itself, or the whole panel, so the screen is up to date before the
+// move. While hallucinating every tile from the old light to the new is
+// drawn, as before, as each one may take a random number.
 static void sub1MoveLight(Coord_t const &from, Coord_t const &to) {
+    LightTile_t lit_tiles[18];
+    int lit_tiles_count = 0;
+
+    Coord_t coord = Coord_t{0, 0};
+    for (coord.y = from.y - 1; coord.y <= from.y + 1; coord.y++) {
+        for (coord.x = from.x - 1; coord.x <= from.x + 1; coord.x++) {
+            lit_tiles[lit_tiles_count++] = LightTile_t{coord, tileLightFlags(dg.floor[coord.y][coord.x])};
+        }
+    }
+    for (coord.y = to.y - 1; coord.y <= to.y + 1; coord.y++) {
+        for (coord.x = to.x - 1; coord.x <= to.x + 1; coord.x++) {
+            if (std::abs(coord.y - from.y) > 1 || std::abs(coord.x - from.x) > 1) {
+                lit_tiles[lit_tiles_count++] = LightTile_t{coord, tileLightFlags(dg.floor[coord.y][coord.x])};
+            }
+        }
+    }
+
     if (py.temporary_light_only) {
         // Turn off lamp light
         for (int y = from.y - 1; y <= from.y + 1; y++) {
@@ -420,7 +554,7 @@ static void sub1MoveLight(Coord_t const &from, Coord_t const &to) {
 
     for (int y = to.y - 1; y <= to.y + 1; y++) {
         for (int x = to.x - 1; x <= to.x + 1; x++) {
-            Tile_t &tile = dg.floor[y][x];
+            Tile_t tile = dg.floor[y][x];
 
             // only light up if normal movement
             if (py.temporary_light_only) {
@@ -439,29 +573,44 @@ static void sub1MoveLight(Coord_t const &from, Coord_t const &to) {
         }
     }
 
-    // From uppermost to bottom most lines player was on.
-    int top, left, bottom, right;
+    if (py.flags.image > 0) {
+        // From uppermost to bottom most lines player was on.
+        int top, left, bottom, right;
 
-    if (from.y < to.y) {
-        top = from.y - 1;
-        bottom = to.y + 1;
-    } else {
-        top = to.y - 1;
-        bottom = from.y + 1;
-    }
-    if (from.x < to.x) {
-        left = from.x - 1;
-        right = to.x + 1;
-    } else {
-        left = to.x - 1;
-        right = from.x + 1;
+        if (from.y < to.y) {
+            top = from.y - 1;
+            bottom = to.y + 1;
+        } else {
+            top = to.y - 1;
+            bottom = from.y + 1;
+        }
+        if (from.x < to.x) {
+            left = from.x - 1;
+            right = to.x + 1;
+        } else {
+            left = to.x - 1;
+            right = from.x + 1;
+        }
+
+        for (coord.y = top; coord.y <= bottom; coord.y++) {
+            // Leftmost to rightmost do
+            for (coord.x = left; coord.x <= right; coord.x++) {
+                panelPutTile(caveGetTileSymbol(coord), coord);
+            }
+        }
+        return;
     }
 
-    Coord_t coord = Coord_t{0, 0};
-    for (coord.y = top; coord.y <= bottom; coord.y++) {
-        // Leftmost to rightmost do
-        for (coord.x = left; coord.x <= right; coord.x++) {
-            panelPutTile(caveGetTileSymbol(coord), coord);
+    // A light "moved" to where it already is is drawn again in full.
+    bool redraw_all = from.y == to.y && from.x == to.x;
+
+    for (int i = 0; i < lit_tiles_count; i++) {
+        LightTile_t const &lit = lit_tiles[i];
+
+        bool moved_between = (lit.coord.y == from.y && lit.coord.x == from.x) || (lit.coord.y == to.y && lit.coord.x == to.x);
+
+        if (redraw_all || moved_between || lit.light_flags != tileLightFlags(dg.floor[lit.coord.y][lit.coord.x])) {
+            panelPutTile(caveGetTileSymbol(lit.coord), lit.coord);
         }
     }
 }
@@ -520,6 +669,7 @@ void dungeonRemoveMonsterFromLevel(int id) {
     // Force the HP negative to ensure that the monster is dead. For example, if the
     // monster was just eaten by another, it will still have positive hit points.
     monster.hp = -1;
+    monsterScheduleWake(id);
 
     dg.floor[monster.pos.y][monster.pos.x].creature_id = 0;
 
@@ -532,19 +682,14 @@ void dungeonRemoveMonsterFromLevel(int id) {
     }
 }
 
-// dungeonDeleteMonsterRecord delete the monster record from the monsters list.
+// dungeonDeleteMonsterRecord delete the monster record from the monsters list,
+// and hands its slot back to be reused. The other monsters keep their ids.
 // Called by updateMonsters() and dungeonDeleteMonster() only.
 void dungeonDeleteMonsterRecord(int id) {
-    int last_id = next_free_monster_id - 1;
-    Monster_t &monster = monsters[last_id];
-
-    if (id != last_id) {
-        dg.floor[monster.pos.y][monster.pos.x].creature_id = (uint8_t) id;
-        monsters[id] = monsters[last_id];
-    }
+    monsterIndexRemove(id);
 
-    monsters[last_id] = blank_monster;
-    next_free_monster_id--;
+    monsters[id] = blank_monster;
+    monsterReleaseSlot(id);
 }
 
 // Creates objects nearby the coordinates given -RAK-
@@ -602,7 +747,7 @@ int dungeonSummonObject(Coord_t coord, int amount, int object_type) {
 
 // Deletes object from given location -RAK-
 bool dungeonDeleteObject(Coord_t const &coord) {
-    Tile_t &tile = dg.floor[coord.y][coord.x];
+    Tile_t tile = dg.floor[coord.y][coord.x];
 
     if (tile.feature_id == TILE_BLOCKED_FLOOR) {
         tile.feature_id = TILE_CORR_FLOOR;
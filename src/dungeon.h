@@ -38,6 +38,92 @@ typedef struct {
     uint8_t depth_first_found; // Dungeon level item first found
 } DungeonObject_t;
 
+// Number of 64-bit words in one row of a dungeon floor bitplane
+constexpr uint8_t TILE_PLANE_WORDS = (MAX_WIDTH + 63) / 64;
+
+// Number of 64-bit words in one column of the opacity column bitplane
+constexpr uint8_t TILE_COLUMN_WORDS = (MAX_HEIGHT + 63) / 64;
+
+// Rooms are built one to a block of the level, half a screen high and wide,
+// and never reach outside of their block.
+constexpr uint8_t ROOM_BLOCK_HEIGHT = (SCREEN_HEIGHT / 2);
+constexpr uint8_t ROOM_BLOCK_WIDTH = (SCREEN_WIDTH / 2);
+constexpr uint8_t ROOM_BLOCK_ROWS = MAX_HEIGHT / ROOM_BLOCK_HEIGHT;
+constexpr uint8_t ROOM_BLOCK_COLUMNS = MAX_WIDTH / ROOM_BLOCK_WIDTH;
+
+// The bounds of the room tiles of a block, those with `perma_lit_room`
+// set. A block with no room has `top_left` below `bottom_right`.
+typedef struct {
+    Coord_t top_left;
+    Coord_t bottom_right;
+} Room_t;
+
+// DungeonFloor_t stores the dungeon tiles as a structure-of-arrays: a dense
+// plane for each of the tile ids, and a bitplane for each of the tile flags.
+//
+// `floor[y][x]` returns a Tile_t referring to a single tile, while scans over
+// many tiles which only need one field should read its plane directly.
+struct DungeonFloor_t {
+    uint16_t creature_id[MAX_HEIGHT][MAX_WIDTH];
+    uint8_t treasure_id[MAX_HEIGHT][MAX_WIDTH];
+    uint8_t feature_id[MAX_HEIGHT][MAX_WIDTH];
+
+    uint64_t perma_lit_room[MAX_HEIGHT][TILE_PLANE_WORDS];
+    uint64_t field_mark[MAX_HEIGHT][TILE_PLANE_WORDS];
+    uint64_t permanent_light[MAX_HEIGHT][TILE_PLANE_WORDS];
+    uint64_t temporary_light[MAX_HEIGHT][TILE_PLANE_WORDS];
+
+    // Tiles whose feature blocks line of sight (`feature_id >= MIN_CLOSED_SPACE`).
+    // These are kept both by row and by column, so that a line along either
+    // axis can be tested a whole word at a time. Assigning to a Tile_t
+    // feature_id keeps them up to date, any direct writes to the feature_id
+    // plane must be followed by a call to rebuildOpacity().
+    uint64_t opaque_rows[MAX_HEIGHT][TILE_PLANE_WORDS];
+    uint64_t opaque_columns[MAX_WIDTH][TILE_COLUMN_WORDS];
+
+    // Incremented whenever the opacity of any tile changes, so that
+    // line of sight results can be cached until the terrain changes.
+    uint32_t opacity_changes;
+
+    // The room of each block, found from the perma_lit_room plane by
+    // rebuildRooms() once a level is built or loaded. Tiles are only ever
+    // taken out of rooms after that, so the bounds never leave any out.
+    Room_t rooms[ROOM_BLOCK_ROWS][ROOM_BLOCK_COLUMNS];
+
+    // Row_t is a single row of the dungeon floor, indexed by column.
+    struct Row_t {
+        DungeonFloor_t &floor;
+        int y;
+
+        Tile_t operator[](int x) const { return floor.tile(y, x); }
+    };
+
+    Row_t operator[](int y) { return Row_t{*this, y}; }
+
+    Tile_t tile(int y, int x) {
+        int word = x >> 6;
+        uint64_t mask = planeBitMask(x);
+
+        return Tile_t{
+            creature_id[y][x],
+            treasure_id[y][x],
+            TileFeature_t(feature_id[y][x], opaque_rows[y][word], mask, opaque_columns[x][y >> 6], planeBitMask(y), opacity_changes),
+            TileFlag_t(perma_lit_room[y][word], mask),
+            TileFlag_t(field_mark[y][word], mask),
+            TileFlag_t(permanent_light[y][word], mask),
+            TileFlag_t(temporary_light[y][word], mask),
+        };
+    }
+
+    bool isOpaque(int y, int x) const { return (opaque_rows[y][x >> 6] & planeBitMask(x)) != 0; }
+
+    void rebuildOpacity();
+    void rebuildRooms();
+
+    // Bit of the column `x` in its bitplane word, `x >> 6`.
+    static uint64_t planeBitMask(int x) { return (uint64_t) 1 << (x & 63); }
+};
+
 typedef struct {
     // Dungeon size is either just big enough for town level, or the whole dungeon itself
     int16_t height;
@@ -55,7 +141,7 @@ typedef struct {
     bool generate_new_level;
 
     // Floor definitions
-    Tile_t floor[MAX_HEIGHT][MAX_WIDTH];
+    DungeonFloor_t floor;
 } Dungeon_t;
 
 extern Dungeon_t dg;
@@ -65,6 +151,7 @@ void dungeonDisplayMap();
 
 bool coordInBounds(Coord_t const &coord);
 int coordDistanceBetween(Coord_t const &from, Coord_t const &to);
+bool dungeonRoomTilesWithin(Coord_t &top_left, Coord_t &bottom_right);
 int coordWallsNextTo(Coord_t const &coord);
 int coordCorridorWallsNextTo(Coord_t const &coord);
 char caveGetTileSymbol(Coord_t const &coord);
@@ -93,7 +180,10 @@ bool dungeonDeleteObject(Coord_t const &coord);
 
 // generate the dungeon
 void generateCave();
+void dungeonPregenerateLevel(int level);
+void dungeonDiscardPregeneratedLevel();
 
 // Line of Sight
 bool los(Coord_t from, Coord_t to);
+bool losFromPlayer(Coord_t const &to);
 void look();
@@ -63,7 +63,13 @@ static void chanceOfRandomDirection(int &vertical, int &horizontal) {
 
 // Blanks out entire cave -RAK-
 static void dungeonBlankEntireCave() {
-    memset((char *) &dg.floor[0][0], 0, sizeof(dg.floor));
+    // Keep counting the opacity changes across levels, so that
+    // no line of sight cached on the old level is used on the new.
+    uint32_t opacity_changes = dg.floor.opacity_changes;
+
+    memset((char *) &dg.floor, 0, sizeof(dg.floor));
+
+    dg.floor.opacity_changes = opacity_changes;
 }
 
 // Fills in empty spots with desired rock -RAK-
@@ -74,54 +80,27 @@ static void dungeonFillEmptyTilesWith(uint8_t rock_type) {
         int x = 1;
 
         for (int j = dg.width - 2; j > 0; j--) {
-            if (dg.floor[y][x].feature_id == TILE_NULL_WALL || dg.floor[y][x].feature_id == TMP1_WALL || dg.floor[y][x].feature_id == TMP2_WALL) {
-                dg.floor[y][x].feature_id = rock_type;
+            uint8_t &feature_id = dg.floor.feature_id[y][x];
+            if (feature_id == TILE_NULL_WALL || feature_id == TMP1_WALL || feature_id == TMP2_WALL) {
+                feature_id = rock_type;
             }
             x++;
         }
     }
 }
 
-#ifdef DEBUG
-#include <assert.h>
-#endif
-
 // Places indestructible rock around edges of dungeon -RAK-
 static void dungeonPlaceBoundaryWalls() {
-    Tile_t(*left_ptr)[MAX_WIDTH];
-    Tile_t(*right_ptr)[MAX_WIDTH];
-
     // put permanent wall on leftmost row and rightmost row
-    left_ptr = (Tile_t(*)[MAX_WIDTH]) & dg.floor[0][0];
-    right_ptr = (Tile_t(*)[MAX_WIDTH]) & dg.floor[0][dg.width - 1];
-
-    for (int i = 0; i < dg.height; i++) {
-#ifdef DEBUG
-        assert((Tile_t *) left_ptr == &dg.floor[i][0]);
-        assert((Tile_t *) right_ptr == &dg.floor[i][dg.width - 1]);
-#endif
-
-        ((Tile_t *) left_ptr)->feature_id = TILE_BOUNDARY_WALL;
-        left_ptr++;
-
-        ((Tile_t *) right_ptr)->feature_id = TILE_BOUNDARY_WALL;
-        right_ptr++;
+    for (int y = 0; y < dg.height; y++) {
+        dg.floor.feature_id[y][0] = TILE_BOUNDARY_WALL;
+        dg.floor.feature_id[y][dg.width - 1] = TILE_BOUNDARY_WALL;
     }
 
     // put permanent wall on top row and bottom row
-    Tile_t *top_ptr = &dg.floor[0][0];
-    Tile_t *bottom_ptr = &dg.floor[dg.height - 1][0];
-
-    for (int i = 0; i < dg.width; i++) {
-#ifdef DEBUG
-        assert(top_ptr == &dg.floor[0][i]);
-        assert(bottom_ptr == &dg.floor[dg.height - 1][i]);
-#endif
-        top_ptr->feature_id = TILE_BOUNDARY_WALL;
-        top_ptr++;
-
-        bottom_ptr->feature_id = TILE_BOUNDARY_WALL;
-        bottom_ptr++;
+    for (int x = 0; x < dg.width; x++) {
+        dg.floor.feature_id[0][x] = TILE_BOUNDARY_WALL;
+        dg.floor.feature_id[dg.height - 1][x] = TILE_BOUNDARY_WALL;
     }
 }
 
@@ -935,7 +914,7 @@ static void dungeonBuildTunnel(Coord_t start, Coord_t end) {
     }
 
     for (int i = 0; i < wall_index; i++) {
-        Tile_t &tile = dg.floor[walls_tk[i].y][walls_tk[i].x];
+        Tile_t tile = dg.floor[walls_tk[i].y][walls_tk[i].x];
 
         if (tile.feature_id == TMP2_WALL) {
             if (randomNumber(100) < config::dungeon::DUN_ROOM_DOORS) {
@@ -968,14 +947,13 @@ static void dungeonPlaceDoorIfNextToTwoWalls(Coord_t coord) {
 
 // Returns random co-ordinates -RAK-
 static void dungeonNewSpot(Coord_t &coord) {
-    Tile_t *tile = nullptr;
     Coord_t position = Coord_t{0, 0};
 
     do {
         position.y = (int32_t) randomNumber(dg.height - 2);
         position.x = (int32_t) randomNumber(dg.width - 2);
-        tile = &dg.floor[position.y][position.x];
-    } while (tile->feature_id >= MIN_CLOSED_SPACE || tile->creature_id != 0 || tile->treasure_id != 0);
+    } while (dg.floor.feature_id[position.y][position.x] >= MIN_CLOSED_SPACE || dg.floor.creature_id[position.y][position.x] != 0 ||
+             dg.floor.treasure_id[position.y][position.x] != 0);
 
     coord.y = position.y;
     coord.x = position.x;
@@ -1164,7 +1142,9 @@ static void monsterLinker() {
     for (auto &monster : monsters) {
         monster = blank_monster;
     }
-    next_free_monster_id = config::monsters::MON_MIN_INDEX_ID;
+    monsterResetSlots();
+    monsterIndexRebuild();
+    monsterScheduleRebuild();
 }
 
 static void dungeonPlaceTownStores() {
@@ -1221,17 +1201,19 @@ static void lightTown() {
 
 // Town logic flow for generation of new town
 static void townGeneration() {
-    seedSet(game.town_seed);
-
-    dungeonPlaceTownStores();
+    {
+        // the town is laid out from its own seed, so it is the same on every visit
+        Rng_t town_rng(game.town_seed);
+        RngStreamScope_t town_rng_scope(town_rng);
 
-    dungeonFillEmptyTilesWith(TILE_DARK_FLOOR);
+        dungeonPlaceTownStores();
 
-    // make stairs before seedResetToOldSeed, so that they don't move around
-    dungeonPlaceBoundaryWalls();
-    dungeonPlaceStairs(2, 1, 0);
+        dungeonFillEmptyTilesWith(TILE_DARK_FLOOR);
 
-    seedResetToOldSeed();
+        // make stairs while still using the town seed, so that they don't move around
+        dungeonPlaceBoundaryWalls();
+        dungeonPlaceStairs(2, 1, 0);
+    }
 
     // Set up the character coords, used by monsterPlaceNewWithinDistance below
     Coord_t coord = Coord_t{0, 0};
@@ -1244,8 +1226,15 @@ static void townGeneration() {
     storeMaintenance();
 }
 
-// Generates a random dungeon level -RAK-
-void generateCave() {
+// Dungeon levels are built from their own random stream, seeded from
+// `game.level_seed` and the depth, so that a level can be built ahead
+// of time and still come out the same (see dungeonPregenerateLevel()).
+static uint32_t dungeonLevelSeed(int level) {
+    return game.level_seed + (uint32_t) level * 2654435761U;
+}
+
+// Builds the level for `dg.current_level` -RAK-
+static void dungeonBuildLevel() {
     dg.panel.top = 0;
     dg.panel.bottom = 0;
     dg.panel.left = 0;
@@ -1276,6 +1265,220 @@ void generateCave() {
     if (dg.current_level == 0) {
         townGeneration();
     } else {
+        Rng_t level_rng(dungeonLevelSeed(dg.current_level));
+        RngStreamScope_t level_rng_scope(level_rng);
+
         dungeonGenerate();
     }
+
+    // Some of the generators write to the feature_id plane directly
+    dg.floor.rebuildOpacity();
+    dg.floor.rebuildRooms();
+}
+
+#ifndef _WIN32
+
+// The level a worker is building, along with everything outside of the
+// level that the building depends on, so that a stale level is never used.
+typedef struct {
+    int16_t level;
+    uint32_t level_seed;
+    int16_t player_speed;
+    bool total_winner;
+    int16_t missiles_counter;
+} LevelRequest_t;
+
+// Everything dungeonBuildLevel() produces, as written by the worker.
+typedef struct {
+    bool complete;
+    int16_t height;
+    int16_t width;
+    Panel_t panel;
+    DungeonFloor_t floor;
+    Coord_t player_pos;
+    bool monster_allocated[MON_TOTAL_ALLOCATIONS];
+    Monster_t monsters[MON_TOTAL_ALLOCATIONS];
+    int16_t treasure_current_id;
+    Inventory_t treasure[LEVEL_MAX_OBJECTS];
+    int16_t missiles_counter;
+} LevelSnapshot_t;
+
+static pid_t level_worker = 0;
+static LevelRequest_t level_worker_request{};
+static LevelSnapshot_t *level_snapshot = nullptr; // shared with the worker
+
+static LevelRequest_t dungeonLevelRequestFor(int level) {
+    LevelRequest_t request{};
+    request.level = (int16_t) level;
+    request.level_seed = game.level_seed;
+    request.player_speed = py.flags.speed;
+    request.total_winner = game.total_winner;
+    request.missiles_counter = missiles_counter;
+    return request;
+}
+
+static bool dungeonLevelRequestsMatch(LevelRequest_t const &a, LevelRequest_t const &b) {
+    return a.level == b.level && a.level_seed == b.level_seed && a.player_speed == b.player_speed && a.total_winner == b.total_winner && a.missiles_counter == b.missiles_counter;
+}
+
+static void dungeonSaveLevelSnapshot(LevelSnapshot_t &snapshot) {
+    snapshot.height = dg.height;
+    snapshot.width = dg.width;
+    snapshot.panel = dg.panel;
+    snapshot.floor = dg.floor;
+    snapshot.player_pos = py.pos;
+
+    for (int id = 0; id < MON_TOTAL_ALLOCATIONS; id++) {
+        snapshot.monster_allocated[id] = id >= config::monsters::MON_MIN_INDEX_ID && monsterIsAllocated(id);
+        snapshot.monsters[id] = monsters[id];
+    }
+
+    snapshot.treasure_current_id = game.treasure.current_id;
+    for (int i = 0; i < LEVEL_MAX_OBJECTS; i++) {
+        snapshot.treasure[i] = game.treasure.list[i];
+    }
+    snapshot.missiles_counter = missiles_counter;
+}
+
+static void dungeonRestoreLevelSnapshot(LevelSnapshot_t const &snapshot) {
+    dg.height = snapshot.height;
+    dg.width = snapshot.width;
+
+    // the printing offsets are not set by building a level, they
+    // stay as the game has them, not as the worker had them
+    int row_prt = dg.panel.row_prt;
+    int col_prt = dg.panel.col_prt;
+    dg.panel = snapshot.panel;
+    dg.panel.row_prt = row_prt;
+    dg.panel.col_prt = col_prt;
+
+    // any change of the counter will do, it only has to tell the
+    // cached line of sight and monster flow map they are out of date
+    uint32_t opacity_changes = dg.floor.opacity_changes;
+    dg.floor = snapshot.floor;
+    dg.floor.opacity_changes = opacity_changes + 1;
+
+    py.pos = snapshot.player_pos;
+
+    monsterResetSlots();
+    for (int id = 0; id < MON_TOTAL_ALLOCATIONS; id++) {
+        monsters[id] = snapshot.monsters[id];
+        if (snapshot.monster_allocated[id]) {
+            monsterClaimSlot(id);
+        }
+    }
+    monsterIndexRebuild();
+    monsterScheduleRebuild();
+
+    game.treasure.current_id = snapshot.treasure_current_id;
+    for (int i = 0; i < LEVEL_MAX_OBJECTS; i++) {
+        game.treasure.list[i] = snapshot.treasure[i];
+    }
+    missiles_counter = snapshot.missiles_counter;
+}
+
+// Stops the worker, throwing away whatever it has built.
+void dungeonDiscardPregeneratedLevel() {
+    if (level_worker == 0) {
+        return;
+    }
+
+    (void) kill(level_worker, SIGKILL);
+    (void) waitpid(level_worker, nullptr, 0);
+    level_worker = 0;
+}
+
+// Starts building `level` in the background, so that going there only has
+// to copy it in. The worker is a fork() of the game, which sees the game as
+// it is right now, and runs the same dungeonBuildLevel() generateCave()
+// would, giving an identical level. The town is never built this way.
+void dungeonPregenerateLevel(int level) {
+    if (level < 1) {
+        return;
+    }
+
+    LevelRequest_t request = dungeonLevelRequestFor(level);
+    if (level_worker != 0 && dungeonLevelRequestsMatch(request, level_worker_request)) {
+        return;
+    }
+
+    dungeonDiscardPregeneratedLevel();
+
+    if (level_snapshot == nullptr) {
+        void *memory = mmap(nullptr, sizeof(LevelSnapshot_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            return;
+        }
+        level_snapshot = (LevelSnapshot_t *) memory;
+    }
+    level_snapshot->complete = false;
+
+    pid_t pid = fork();
+    if (pid == -1) {
+        return;
+    }
+
+    if (pid == 0) {
+        terminalDetach();
+
+        dg.current_level = (int16_t) level;
+        dungeonBuildLevel();
+
+        dungeonSaveLevelSnapshot(*level_snapshot);
+        level_snapshot->complete = true;
+
+        _exit(0);
+    }
+
+    level_worker = pid;
+    level_worker_request = request;
+}
+
+// Copies in the level built by the worker, if it was building this one.
+static bool dungeonUsePregeneratedLevel() {
+    if (level_worker == 0) {
+        return false;
+    }
+
+    if (!dungeonLevelRequestsMatch(dungeonLevelRequestFor(dg.current_level), level_worker_request)) {
+        dungeonDiscardPregeneratedLevel();
+        return false;
+    }
+
+    int status = 0;
+    bool built = waitpid(level_worker, &status, 0) == level_worker && WIFEXITED(status) && WEXITSTATUS(status) == 0 && level_snapshot->complete;
+    level_worker = 0;
+
+    if (built) {
+        dungeonRestoreLevelSnapshot(*level_snapshot);
+    }
+
+    return built;
+}
+
+#else
+
+// Windows has no fork(), levels are only ever built when they are entered.
+void dungeonPregenerateLevel(int level) {
+    (void) level;
+}
+
+void dungeonDiscardPregeneratedLevel() {}
+
+static bool dungeonUsePregeneratedLevel() {
+    return false;
+}
+
+#endif
+
+// Generates a random dungeon level -RAK-
+void generateCave() {
+    TURN_STATS_PHASE(TurnPhase::Level);
+
+    if (!dungeonUsePregeneratedLevel()) {
+        dungeonBuildLevel();
+    }
+
+    // the next dungeon level gets a new seed
+    game.level_seed = (uint32_t) rnd();
 }
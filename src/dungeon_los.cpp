@@ -10,6 +10,30 @@
 
 #include "headers.h"
 
+// Returns true if no bit between the positions `from` and `to` (exclusive)
+// is set in the bitplane `words`, testing a whole word at a time.
+static bool losPlaneSpanIsClear(uint64_t const *words, int from, int to) {
+    int first = from + 1;
+    int last = to - 1;
+
+    for (int word = first >> 6; word <= last >> 6; word++) {
+        uint64_t bits = words[word];
+
+        if (word == first >> 6) {
+            bits &= ~(uint64_t) 0 << (first & 63);
+        }
+        if (word == last >> 6) {
+            bits &= ~(uint64_t) 0 >> (63 - (last & 63));
+        }
+
+        if (bits != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 // A simple, fast, integer-based line-of-sight algorithm.  By Joseph Hall,
 // 4116 Brewster Drive, Raleigh NC 27606.  Email to jnh@ecemwl.ncsu.edu.
 //
@@ -26,6 +50,8 @@
 // Because this function uses (short) ints for all calculations, overflow may
 // occur if deltaX and deltaY exceed 90.
 bool los(Coord_t from, Coord_t to) {
+    TURN_STATS_COUNT(TurnCounter::LosCalls);
+
     int delta_x = to.x - from.x;
     int delta_y = to.y - from.y;
 
@@ -42,13 +68,7 @@ bool los(Coord_t from, Coord_t to) {
             to.y = tmp;
         }
 
-        for (int yy = from.y + 1; yy < to.y; yy++) {
-            if (dg.floor[yy][from.x].feature_id >= MIN_CLOSED_SPACE) {
-                return false;
-            }
-        }
-
-        return true;
+        return losPlaneSpanIsClear(dg.floor.opaque_columns[from.x], from.y, to.y);
     }
 
     if (delta_y == 0) {
@@ -58,13 +78,7 @@ bool los(Coord_t from, Coord_t to) {
             to.x = tmp;
         }
 
-        for (int xx = from.x + 1; xx < to.x; xx++) {
-            if (dg.floor[from.y][xx].feature_id >= MIN_CLOSED_SPACE) {
-                return false;
-            }
-        }
-
-        return true;
+        return losPlaneSpanIsClear(dg.floor.opaque_rows[from.y], from.x, to.x);
     }
 
     // Now, we've eliminated all the degenerate cases.
@@ -112,7 +126,7 @@ bool los(Coord_t from, Coord_t to) {
             }
 
             while ((to.x - xx) != 0) {
-                if (dg.floor[yy][xx].feature_id >= MIN_CLOSED_SPACE) {
+                if (dg.floor.isOpaque(yy, xx)) {
                     return false;
                 }
 
@@ -122,7 +136,7 @@ bool los(Coord_t from, Coord_t to) {
                     xx += x_sign;
                 } else if (dy > scale_half) {
                     yy += y_sign;
-                    if (dg.floor[yy][xx].feature_id >= MIN_CLOSED_SPACE) {
+                    if (dg.floor.isOpaque(yy, xx)) {
                         return false;
                     }
                     xx += x_sign;
@@ -153,7 +167,7 @@ bool los(Coord_t from, Coord_t to) {
         }
 
         while ((to.y - yy) != 0) {
-            if (dg.floor[yy][xx].feature_id >= MIN_CLOSED_SPACE) {
+            if (dg.floor.isOpaque(yy, xx)) {
                 return false;
             }
 
@@ -163,7 +177,7 @@ bool los(Coord_t from, Coord_t to) {
                 yy += y_sign;
             } else if (dx > scale_half) {
                 xx += x_sign;
-                if (dg.floor[yy][xx].feature_id >= MIN_CLOSED_SPACE) {
+                if (dg.floor.isOpaque(yy, xx)) {
                     return false;
                 }
                 yy += y_sign;
@@ -178,6 +192,39 @@ bool los(Coord_t from, Coord_t to) {
     }
 }
 
+// Cache of the los() results from the player's position. A tile's result is
+// only traced the first time it is asked for, and the whole cache is dropped
+// when the player moves or the opacity of any tile changes.
+static Coord_t los_cache_origin = Coord_t{-1, -1};
+static uint32_t los_cache_opacity_changes = 0;
+static uint64_t los_cache_known[MAX_HEIGHT][TILE_PLANE_WORDS];
+static uint64_t los_cache_visible[MAX_HEIGHT][TILE_PLANE_WORDS];
+
+// Returns true if a line of sight can be traced from the player to the tile.
+bool losFromPlayer(Coord_t const &to) {
+    if (los_cache_origin.y != py.pos.y || los_cache_origin.x != py.pos.x || los_cache_opacity_changes != dg.floor.opacity_changes) {
+        los_cache_origin = py.pos;
+        los_cache_opacity_changes = dg.floor.opacity_changes;
+        memset(los_cache_known, 0, sizeof(los_cache_known));
+    }
+
+    uint64_t &known = los_cache_known[to.y][to.x >> 6];
+    uint64_t &visible = los_cache_visible[to.y][to.x >> 6];
+    uint64_t mask = DungeonFloor_t::planeBitMask(to.x);
+
+    if ((known & mask) == 0) {
+        known |= mask;
+
+        if (los(py.pos, to)) {
+            visible |= mask;
+        } else {
+            visible &= ~mask;
+        }
+    }
+
+    return (visible & mask) != 0;
+}
+
 /*
   An enhanced look, with peripheral vision. Looking all 8 -CJS- directions will
   see everything which ought to be visible. Can specify direction 5, which looks
@@ -8,18 +8,6 @@
 
 #pragma once
 
-// Tile_t holds data about a specific tile in the dungeon.
-typedef struct {
-    uint8_t creature_id; // ID for any creature occupying the tile
-    uint8_t treasure_id; // ID for any treasure item occupying the tile
-    uint8_t feature_id;  // ID of cave feature; walls, floors, open space, etc.
-
-    bool perma_lit_room : 1;  // Room should be lit with perm light, walls with this set should be perm lit after tunneled out.
-    bool field_mark : 1;      // Field mark, used for traps/doors/stairs, object is hidden if fm is false.
-    bool permanent_light : 1; // Permanent light, used for walls and lighted rooms.
-    bool temporary_light : 1; // Temporary light, used for player's lamp light,etc.
-} Tile_t;
-
 // `fval` definitions: these describe the various types of dungeon floors and
 // walls, if numbers above 15 are ever used, then the test against MIN_CAVE_WALL
 // will have to be changed, also the save routines will have to be changed.
@@ -42,3 +30,95 @@ constexpr uint8_t TILE_GRANITE_WALL = 12;
 constexpr uint8_t TILE_MAGMA_WALL = 13;
 constexpr uint8_t TILE_QUARTZ_WALL = 14;
 constexpr uint8_t TILE_BOUNDARY_WALL = 15;
+
+// TileFlag_t refers to a single bit in one of the dungeon floor bitplanes,
+// so that a tile flag can be read and assigned to like a plain `bool`.
+class TileFlag_t {
+public:
+    TileFlag_t(uint64_t &plane_word, uint64_t bit_mask) : word(plane_word), mask(bit_mask) {
+    }
+    TileFlag_t(TileFlag_t const &flag) = default;
+
+    operator bool() const {
+        return (word & mask) != 0;
+    }
+
+    TileFlag_t &operator=(bool value) {
+        if (value) {
+            word |= mask;
+        } else {
+            word &= ~mask;
+        }
+        return *this;
+    }
+
+    TileFlag_t &operator=(TileFlag_t const &flag) {
+        return *this = (bool) flag;
+    }
+
+private:
+    uint64_t &word;
+    uint64_t mask;
+};
+
+// TileFeature_t refers to the feature id of a tile. Assigning a new feature
+// also updates the tile's bits in the dungeon floor opacity bitplanes, and
+// counts the change of opacity, if there was one.
+class TileFeature_t {
+public:
+    TileFeature_t(uint8_t &feature, uint64_t &row_word, uint64_t row_mask, uint64_t &column_word, uint64_t column_mask, uint32_t &changes)
+        : id(feature), opaque_row_word(row_word), opaque_row_mask(row_mask), opaque_column_word(column_word), opaque_column_mask(column_mask),
+          opacity_changes(changes) {
+    }
+    TileFeature_t(TileFeature_t const &feature) = default;
+
+    operator uint8_t() const {
+        return id;
+    }
+
+    TileFeature_t &operator=(uint8_t feature_id) {
+        id = feature_id;
+
+        bool opaque = feature_id >= MIN_CLOSED_SPACE;
+        if (opaque != ((opaque_row_word & opaque_row_mask) != 0)) {
+            opacity_changes++;
+        }
+
+        if (opaque) {
+            opaque_row_word |= opaque_row_mask;
+            opaque_column_word |= opaque_column_mask;
+        } else {
+            opaque_row_word &= ~opaque_row_mask;
+            opaque_column_word &= ~opaque_column_mask;
+        }
+        return *this;
+    }
+
+    TileFeature_t &operator=(TileFeature_t const &feature) {
+        return *this = (uint8_t) feature;
+    }
+
+private:
+    uint8_t &id;
+    uint64_t &opaque_row_word;
+    uint64_t opaque_row_mask;
+    uint64_t &opaque_column_word;
+    uint64_t opaque_column_mask;
+    uint32_t &opacity_changes;
+};
+
+// Tile_t holds data about a specific tile in the dungeon.
+//
+// The dungeon floor stores each field in a separate plane (see DungeonFloor_t),
+// so a Tile_t only refers to the data of its tile: assigning to one of
+// the fields updates the dungeon floor itself.
+typedef struct {
+    uint16_t &creature_id;    // ID for any creature occupying the tile
+    uint8_t &treasure_id;     // ID for any treasure item occupying the tile
+    TileFeature_t feature_id; // ID of cave feature; walls, floors, open space, etc.
+
+    TileFlag_t perma_lit_room;  // Room should be lit with perm light, walls with this set should be perm lit after tunneled out.
+    TileFlag_t field_mark;      // Field mark, used for traps/doors/stairs, object is hidden if fm is false.
+    TileFlag_t permanent_light; // Permanent light, used for walls and lighted rooms.
+    TileFlag_t temporary_light; // Temporary light, used for player's lamp light,etc.
+} Tile_t;
@@ -11,9 +11,6 @@
 #include "headers.h"
 #include "version.h"
 
-// holds the previous rnd state
-static uint32_t old_seed;
-
 Game_t game = Game_t{};
 
 // gets a new random seed for the random number generator
@@ -32,25 +29,18 @@ void seedsInitialize(uint32_t seed) {
     game.town_seed = (int32_t) clock_var;
 
     clock_var += 113452L;
-    setRandomSeed(clock_var);
+    rng_streams.main.setSeed(clock_var);
 
     // make it a little more random
-    for (clock_var = (uint32_t) randomNumber(100); clock_var != 0; clock_var--) {
-        (void) rnd();
+    for (clock_var = (uint32_t) rng_streams.main.randomNumber(100); clock_var != 0; clock_var--) {
+        (void) rng_streams.main.next();
     }
-}
 
-// change to different random number generator state
-void seedSet(uint32_t seed) {
-    old_seed = getRandomSeed();
-
-    // want reproducible state here
-    setRandomSeed(seed);
-}
+    rng_streams.monsters = rng_streams.main.split();
+    rng_streams.combat = rng_streams.main.split();
+    rng_streams.stores = rng_streams.main.split();
 
-// restore the normal random generator state
-void seedResetToOldSeed() {
-    setRandomSeed(old_seed);
+    game.level_seed = (uint32_t) rng_streams.main.next();
 }
 
 // Generates a random integer x where 1<=X<=MAXVAL -RAK-
@@ -133,6 +123,7 @@ static struct {
     {"Highlight and notice mineral seams", &config::options::highlight_seams},
     {"Beep for invalid character", &config::options::error_beep_sound},
     {"Display rest/repeat counts", &config::options::display_counts},
+    {"Animate projectiles in flight", &config::options::animate_projectiles},
     {nullptr, nullptr},
 };
 
@@ -326,6 +317,7 @@ bool getAllDirections(const char *prompt, int &direction) {
 
 // Restore the terminal and exit
 void exitProgram() {
+    dungeonDiscardPregeneratedLevel();
     flushInputBuffer();
     terminalRestore();
     exit(0);
@@ -333,6 +325,7 @@ void exitProgram() {
 
 // Abort the program with a message displayed on the terminal.
 void abortProgram(const char *msg) {
+    dungeonDiscardPregeneratedLevel();
     flushInputBuffer();
     terminalRestore();
 
@@ -28,6 +28,7 @@ constexpr uint8_t NORMAL_TABLE_SD = 64; // the standard deviation for the table
 typedef struct {
     uint32_t magic_seed = 0; // Seed for initializing magic items (Potions, Wands, Staves, Scrolls, etc.)
     uint32_t town_seed = 0;  // Seed for town generation
+    uint32_t level_seed = 0; // Seed for generating the next dungeon level
 
     bool character_generated = false; // Don't save score until character generation is finished
     bool character_saved = false;     // Prevents save on kill after saving a character
@@ -62,8 +63,6 @@ extern uint16_t normal_table[NORMAL_TABLE_SIZE];
 extern int16_t treasure_levels[TREASURE_MAX_LEVELS + 1];
 
 void seedsInitialize(uint32_t seed);
-void seedSet(uint32_t seed);
-void seedResetToOldSeed();
 int randomNumber(int max);
 int randomNumberNormalDistribution(int mean, int standard);
 void setGameOptions();
@@ -100,4 +99,6 @@ void setFileptr(FILE *file);
 
 // game_run.cpp
 // (includes the playDungeon() main game loop)
+void gameInitialize(uint32_t seed);
+void gameCreateCharacter();
 void startMoria(int seed, bool start_new_game);
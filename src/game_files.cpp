@@ -18,10 +18,15 @@
 //  when the score is being written out, you must be sure to flock the file
 //  so we don't have multiple people trying to write to it at the same time.
 //  Craig Norborg (doc)    Mon Aug 10 16:41:59 EST 1987
+//  The score file is shared with other games through mmap() and fcntl()
+//  locks, so the stream is left unbuffered to never read stale data.
 bool initializeScoreFile() {
     highscore_fp = fopen(config::files::scores.c_str(), (char *) "rb+");
+    if (highscore_fp == nullptr) {
+        return false;
+    }
 
-    return highscore_fp != nullptr;
+    return setvbuf(highscore_fp, nullptr, _IONBF, 0) == 0;
 }
 
 // Attempt to open and print the file containing the intro splash screen text -RAK-
@@ -25,10 +25,10 @@ static void compactObjects() {
     while (counter <= 0) {
         for (coord.y = 0; coord.y < dg.height; coord.y++) {
             for (coord.x = 0; coord.x < dg.width; coord.x++) {
-                if (dg.floor[coord.y][coord.x].treasure_id != 0 && coordDistanceBetween(coord, py.pos) > current_distance) {
+                if (dg.floor.treasure_id[coord.y][coord.x] != 0 && coordDistanceBetween(coord, py.pos) > current_distance) {
                     int chance;
 
-                    switch (game.treasure.list[dg.floor[coord.y][coord.x].treasure_id].category_id) {
+                    switch (game.treasure.list[dg.floor.treasure_id[coord.y][coord.x]].category_id) {
                         case TV_VIS_TRAP:
                             chance = 15;
                             break;
@@ -88,8 +88,8 @@ void pusht(uint8_t treasure_id) {
         // must change the treasure_id in the cave of the object just moved
         for (int y = 0; y < dg.height; y++) {
             for (int x = 0; x < dg.width; x++) {
-                if (dg.floor[y][x].treasure_id == game.treasure.current_id - 1) {
-                    dg.floor[y][x].treasure_id = treasure_id;
+                if (dg.floor.treasure_id[y][x] == game.treasure.current_id - 1) {
+                    dg.floor.treasure_id[y][x] = treasure_id;
                 }
             }
         }
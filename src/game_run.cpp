@@ -9,6 +9,7 @@
 // Run the game: the main loop
 
 #include "headers.h"
+#include <algorithm>
 
 static void playDungeon();
 
@@ -25,21 +26,20 @@ static bool itemEnchanted(Inventory_t const &item);
 static void examineBook();
 static void dungeonGoUpLevel();
 static void dungeonGoDownLevel();
+static void dungeonPregenerateStairsLevel();
 static void dungeonJamDoor();
 static void inventoryRefillLamp();
 
-void startMoria(int seed, bool start_new_game) {
+// Sets up everything needed before a character is created or restored.
+void gameInitialize(uint32_t seed) {
     // Roguelike keys are disabled by default.
     // This will be overridden by the setting in the game save file.
     config::options::use_roguelike_keys = false;
 
     priceAdjust();
 
-    // Show the game splash screen
-    displaySplashScreen();
-
     // Grab a random seed from the clock
-    seedsInitialize(static_cast<uint32_t>(seed));
+    seedsInitialize(seed);
 
     // Init monster and treasure levels for allocate
     initializeMonsterLevels();
@@ -55,6 +55,45 @@ void startMoria(int seed, bool start_new_game) {
     py.flags.spells_learnt = 0;
     py.flags.spells_worked = 0;
     py.flags.spells_forgotten = 0;
+}
+
+// Creates a new character, with its starting inventory and spells.
+void gameCreateCharacter() {
+    characterCreate();
+
+    py.misc.date_of_birth = getCurrentUnixTime();
+
+    initializeCharacterInventory();
+    py.flags.food = 7500;
+    py.flags.food_digested = 2;
+
+    // Spell and Mana based on class: Mage or Clerical realm.
+    if (classes[py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
+        clearScreen(); // makes spell list easier to read
+        playerCalculateAllowedSpellsCount(PlayerAttr::A_INT);
+        playerGainMana(PlayerAttr::A_INT);
+    } else if (classes[py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_PRIEST) {
+        playerCalculateAllowedSpellsCount(PlayerAttr::A_WIS);
+        clearScreen(); // force out the 'learn prayer' message
+        playerGainMana(PlayerAttr::A_WIS);
+    }
+
+    // Set some default values -MRC-
+    py.temporary_light_only = false;
+    py.weapon_is_heavy = false;
+    py.pack.heaviness = 0;
+
+    // prevent ^c quit from entering score into scoreboard,
+    // and prevent signal from creating panic save until this
+    // point, all info needed for save file is now valid.
+    game.character_generated = true;
+}
+
+void startMoria(int seed, bool start_new_game) {
+    // Show the game splash screen
+    displaySplashScreen();
+
+    gameInitialize(static_cast<uint32_t>(seed));
 
     // If -n is not passed, the calling routine will know
     // save file name, hence, this code is not necessary.
@@ -80,6 +119,9 @@ void startMoria(int seed, bool start_new_game) {
     }
 
     if (result) {
+        // a replay starts from a new character, it can't be made of a restored one
+        replayAbandonRecording();
+
         changeCharacterName();
 
         // could be restoring a dead character after a signal or HANGUP
@@ -87,35 +129,7 @@ void startMoria(int seed, bool start_new_game) {
             game.character_is_dead = true;
         }
     } else {
-        // Create character
-        characterCreate();
-
-        py.misc.date_of_birth = getCurrentUnixTime();
-
-        initializeCharacterInventory();
-        py.flags.food = 7500;
-        py.flags.food_digested = 2;
-
-        // Spell and Mana based on class: Mage or Clerical realm.
-        if (classes[py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_MAGE) {
-            clearScreen(); // makes spell list easier to read
-            playerCalculateAllowedSpellsCount(PlayerAttr::A_INT);
-            playerGainMana(PlayerAttr::A_INT);
-        } else if (classes[py.misc.class_id].class_to_use_mage_spells == config::spells::SPELL_TYPE_PRIEST) {
-            playerCalculateAllowedSpellsCount(PlayerAttr::A_WIS);
-            clearScreen(); // force out the 'learn prayer' message
-            playerGainMana(PlayerAttr::A_WIS);
-        }
-
-        // Set some default values -MRC-
-        py.temporary_light_only = false;
-        py.weapon_is_heavy = false;
-        py.pack.heaviness = 0;
-
-        // prevent ^c quit from entering score into scoreboard,
-        // and prevent signal from creating panic save until this
-        // point, all info needed for save file is now valid.
-        game.character_generated = true;
+        gameCreateCharacter();
         generate = true;
     }
 
@@ -885,7 +899,7 @@ static void playerUpdateWordOfRecall() {
     }
 }
 
-static void playerUpdateStatusFlags() {
+static void playerUpdateStatusFlags(bool show_resting) {
     if ((py.flags.status & config::player::status::PY_SPEED) != 0u) {
         py.flags.status &= ~config::player::status::PY_SPEED;
         printCharacterSpeed();
@@ -897,7 +911,7 @@ static void playerUpdateStatusFlags() {
     } else if (py.flags.paralysis > 0) {
         printCharacterMovementState();
         py.flags.status |= config::player::status::PY_PARALYSED;
-    } else if (py.flags.rest != 0) {
+    } else if (py.flags.rest != 0 && show_resting) {
         printCharacterMovementState();
     }
 
@@ -951,6 +965,273 @@ static void playerDetectEnchantment() {
     }
 }
 
+// Allow for a slim chance of detect enchantment -CJS-
+// for 1st level char, check once every 2160 turns
+// for 40th level char, check once every 416 turns
+static void playerRollDetectEnchantment() {
+    int chance = 10 + 750 / (5 + py.misc.level);
+    if ((dg.game_turn & 0xF) == 0 && py.flags.confused == 0 && randomNumber(chance) == 1) {
+        playerDetectEnchantment();
+    }
+}
+
+// Starts the next turn, returns true if a new monster was rolled for.
+static bool dungeonBeginTurn() {
+    // Increment turn counter
+    dg.game_turn++;
+    TURN_STATS_BEGIN_TURN(dg.game_turn);
+
+    // turn over the store contents every, say, 1000 turns
+    if (dg.current_level != 0 && dg.game_turn % 1000 == 0) {
+        storeMaintenance();
+    }
+
+    // Check for creature generation
+    if (randomNumber(config::monsters::MON_CHANCE_OF_NEW) != 1) {
+        return false;
+    }
+
+    monsterPlaceNewWithinDistance(1, config::monsters::MON_MAX_SIGHT, false);
+
+    return true;
+}
+
+// Update the player's status
+static void playerUpdateStatus() {
+    TURN_STATS_PHASE(TurnPhase::Status);
+
+    playerUpdateLightStatus();
+
+    //
+    // Update counters and messages
+    //
+
+    // Heroism and Super Heroism must precede anything that can damage player
+    playerUpdateHeroStatus();
+
+    int regen_amount = playerFoodConsumption();
+    playerUpdateRegeneration(regen_amount);
+
+    playerUpdateBlindness();
+    playerUpdateConfusion();
+    playerUpdateFearState();
+    playerUpdatePoisonedState();
+    playerUpdateSpeed();
+    playerUpdateRestingState();
+
+    // Check for interrupts to find or rest.
+    // Resting and repeated commands only poll every few turns.
+    bool poll_for_key = (py.running_tracker != 0) || ((game.command_count > 0 || py.flags.rest != 0) && dg.game_turn % KEY_PRESS_POLL_TURNS == 0);
+    if (poll_for_key && checkForNonBlockingKeyPress()) {
+        playerDisturb(0, 0);
+    }
+
+    playerUpdateHallucination();
+    playerUpdateParalysis();
+    playerUpdateEvilProtection();
+    playerUpdateInvulnerability();
+    playerUpdateBlessedness();
+    playerUpdateHeatResistance();
+    playerUpdateColdResistance();
+    playerUpdateDetectInvisible();
+    playerUpdateInfraVision();
+    playerUpdateWordOfRecall();
+
+    // Random teleportation
+    if (py.flags.teleport && randomNumber(100) == 1) {
+        playerDisturb(0, 0);
+        playerTeleport(40);
+    }
+
+    // See if we are too weak to handle the weapon or pack. -CJS-
+    if ((py.flags.status & config::player::status::PY_STR_WGT) != 0u) {
+        playerStrength();
+    }
+
+    if ((py.flags.status & config::player::status::PY_STUDY) != 0u) {
+        printCharacterStudyInstruction();
+    }
+
+    playerUpdateStatusFlags(true);
+
+    playerRollDetectEnchantment();
+}
+
+// The turns a timed effect can go on counting down for before the turn it
+// runs out on. `status` is the flag it sets on the turn it takes effect,
+// if it has one.
+static int playerTimedEffectQuietTurns(int16_t counter, uint32_t status) {
+    if (counter <= 0) {
+        return INT_MAX;
+    }
+
+    if (status != 0 && (py.flags.status & status) == 0u) {
+        return 0;
+    }
+
+    return counter - 1;
+}
+
+static void playerTimedEffectElapse(int16_t &counter, int turns) {
+    if (counter > 0) {
+        counter = (int16_t)(counter - turns);
+    }
+}
+
+// The turns the light burns for before it is growing faint.
+static int playerLightQuietTurns() {
+    Inventory_t const &item = py.inventory[PlayerEquipment::Light];
+
+    if (py.carrying_light) {
+        return item.misc_use > 40 ? item.misc_use - 40 : 0;
+    }
+
+    return item.misc_use > 0 ? 0 : INT_MAX;
+}
+
+// The turns before the player is getting hungry.
+static int playerFoodQuietTurns() {
+    if (py.flags.food < config::player::PLAYER_FOOD_ALERT) {
+        return 0;
+    }
+
+    int per_turn = py.flags.food_digested;
+    if (py.flags.speed < 0) {
+        per_turn += py.flags.speed * py.flags.speed;
+    }
+
+    if (per_turn <= 0) {
+        return INT_MAX;
+    }
+
+    return (py.flags.food - config::player::PLAYER_FOOD_ALERT) / per_turn;
+}
+
+// The turns of a rest that playerRestQuietly() can play out: every monster
+// is dormant, and on none of the turns does a timed effect run out, or the
+// light, food or anything else about the player need seeing to.
+static int playerRestQuietTurns() {
+    uint32_t unsettled = config::player::status::PY_SPEED | config::player::status::PY_PARALYSED | config::player::status::PY_ARMOR |
+                         config::player::status::PY_STATS | config::player::status::PY_HP | config::player::status::PY_MANA |
+                         config::player::status::PY_STR_WGT | config::player::status::PY_STUDY;
+
+    if (py.flags.rest == 0 || (py.flags.status & unsettled) != 0u || py.running_tracker != 0) {
+        return 0;
+    }
+
+    if (py.flags.poisoned > 0 || py.flags.image > 0 || py.flags.paralysis > 0 || py.flags.teleport) {
+        return 0;
+    }
+
+    // heroism would shake off the fear
+    if (py.flags.afraid > 0 && py.flags.heroism + py.flags.super_heroism > 0) {
+        return 0;
+    }
+
+    if (game.teleport_player || dg.generate_new_level || game.character_is_dead) {
+        return 0;
+    }
+
+    if (monsterFreeSlotsTotal() < 10 || !monsterAllDormant()) {
+        return 0;
+    }
+
+    int turns = std::min(playerLightQuietTurns(), playerFoodQuietTurns());
+
+    turns = std::min(turns, playerTimedEffectQuietTurns(py.flags.heroism, config::player::status::PY_HERO));
+    turns = std::min(turns, playerTimedEffectQuietTurns(py.flags.super_heroism, config::player::status::PY_SHERO));
+    turns = std::min(turns, playerTimedEffectQuietTurns(py.flags.blind, config::player::status::PY_BLIND));
+    turns = std::min(turns, playerTimedEffectQuietTurns(py.flags.confused, config::player::status::PY_CONFUSED));
+    turns = std::min(turns, playerTimedEffectQuietTurns(py.flags.afraid, config::player::status::PY_FEAR));
+    turns = std::min(turns, playerTimedEffectQuietTurns(py.flags.fast, config::player::status::PY_FAST));
+    turns = std::min(turns, playerTimedEffectQuietTurns(py.flags.slow, config::player::status::PY_SLOW));
+    turns = std::min(turns, playerTimedEffectQuietTurns(py.flags.protect_evil, 0));
+    turns = std::min(turns, playerTimedEffectQuietTurns(py.flags.invulnerability, config::player::status::PY_INVULN));
+    turns = std::min(turns, playerTimedEffectQuietTurns(py.flags.blessed, config::player::status::PY_BLESSED));
+    turns = std::min(turns, playerTimedEffectQuietTurns(py.flags.heat_resistance, 0));
+    turns = std::min(turns, playerTimedEffectQuietTurns(py.flags.cold_resistance, 0));
+    turns = std::min(turns, playerTimedEffectQuietTurns(py.flags.detect_invisible, config::player::status::PY_DET_INV));
+    turns = std::min(turns, playerTimedEffectQuietTurns(py.flags.timed_infra, config::player::status::PY_TIM_INFRA));
+    turns = std::min(turns, playerTimedEffectQuietTurns(py.flags.word_of_recall, 0));
+
+    return turns;
+}
+
+// Plays out the turns of a rest in a tight loop while nothing can happen
+// on them, see playerRestQuietTurns(). Each turn still rolls for a new
+// monster, polls for a key press when any other would, regenerates, and
+// burns food and light, but there is no monster pass, as it would find no
+// monster to move, and the screen is only brought up to date on the turns
+// that poll for a key. The timed effects are counted down once the turns
+// are over.
+//
+// Returns false when it stopped before a turn, which is left to be played
+// out in full, or true when it stopped after the status of a turn, as a
+// monster turned up or the rest ended, leaving the rest of that turn.
+static bool playerRestQuietly() {
+    int turns = playerRestQuietTurns();
+    if (turns == 0) {
+        return false;
+    }
+
+    Inventory_t &light = py.inventory[PlayerEquipment::Light];
+
+    int played = 0;
+    bool stopped = false;
+
+    while (!stopped && played < turns) {
+        bool new_monster = dungeonBeginTurn();
+        played++;
+
+        TURN_STATS_PHASE(TurnPhase::Status);
+
+        if (py.carrying_light) {
+            light.misc_use--;
+        }
+
+        if (py.flags.speed < 0) {
+            py.flags.food -= py.flags.speed * py.flags.speed;
+        }
+        py.flags.food -= py.flags.food_digested;
+
+        playerUpdateRegeneration(config::player::PLAYER_REGEN_NORMAL);
+        playerUpdateRestingState();
+
+        bool poll_for_key = (game.command_count > 0 || py.flags.rest != 0) && dg.game_turn % KEY_PRESS_POLL_TURNS == 0;
+        if (poll_for_key && checkForNonBlockingKeyPress()) {
+            playerDisturb(0, 0);
+        }
+
+        playerUpdateStatusFlags(poll_for_key);
+        playerRollDetectEnchantment();
+
+        stopped = new_monster || py.flags.rest == 0 || eof_flag != 0;
+
+        if (!stopped && poll_for_key) {
+            panelMoveCursor(py.pos);
+            putQIO();
+        }
+    }
+
+    playerTimedEffectElapse(py.flags.heroism, played);
+    playerTimedEffectElapse(py.flags.super_heroism, played);
+    playerTimedEffectElapse(py.flags.blind, played);
+    playerTimedEffectElapse(py.flags.confused, played);
+    playerTimedEffectElapse(py.flags.afraid, played);
+    playerTimedEffectElapse(py.flags.fast, played);
+    playerTimedEffectElapse(py.flags.slow, played);
+    playerTimedEffectElapse(py.flags.protect_evil, played);
+    playerTimedEffectElapse(py.flags.invulnerability, played);
+    playerTimedEffectElapse(py.flags.blessed, played);
+    playerTimedEffectElapse(py.flags.heat_resistance, played);
+    playerTimedEffectElapse(py.flags.cold_resistance, played);
+    playerTimedEffectElapse(py.flags.detect_invisible, played);
+    playerTimedEffectElapse(py.flags.timed_infra, played);
+    playerTimedEffectElapse(py.flags.word_of_recall, played);
+
+    return stopped;
+}
+
 static int getCommandRepeatCount(char &last_input_command) {
     putStringClearToEOL("Repeat count:", Coord_t{0, 0});
 
@@ -1018,6 +1299,8 @@ static char parseAlternateCtrlInput(char last_input_command) {
 
 // Accept a command and execute it
 static void executeInputCommands(char &command, int &find_count) {
+    TURN_STATS_PHASE(TurnPhase::Commands);
+
     char last_input_command = command;
 
     // Accept a command and execute it
@@ -1310,6 +1593,8 @@ static char originalCommands(char command) {
             break;
         case CTRL_KEY('I'): // ^I = identify
             break;
+        case CTRL_KEY('S'): // ^S = turn stats
+            break;
         case CTRL_KEY('L'): // ^L = wizlight
             command = '*';
             break;
@@ -1419,25 +1704,28 @@ static void commandPreviousMessage() {
     if (max_messages <= 1) {
         // Distinguish real and recovered messages with a '>'. -CJS-
         putString(">", Coord_t{0, 0});
-        putStringClearToEOL(messages[last_message_id], Coord_t{0, 1});
+        vtype_t text = {'\0'};
+        messageHistorySlotText(messageHistoryNewestSlot(), text);
+        putStringClearToEOL(text, Coord_t{0, 1});
         return;
     }
 
     terminalSaveScreen();
 
     uint8_t line_number = max_messages;
-    int16_t msg_id = last_message_id;
+    uint32_t sequence = messageHistoryNewest();
+    MessageRecord_t record{};
 
     while (max_messages > 0) {
         max_messages--;
 
-        putStringClearToEOL(messages[msg_id], Coord_t{max_messages, 0});
-
-        if (msg_id == 0) {
-            msg_id = MESSAGE_HISTORY_SIZE - 1;
-        } else {
-            msg_id--;
+        vtype_t text = {'\0'};
+        if (messageHistoryRead(sequence, record)) {
+            messageRecordText(record, text);
         }
+        putStringClearToEOL(text, Coord_t{max_messages, 0});
+
+        sequence--;
     }
 
     eraseLine(Coord_t{line_number, 0});
@@ -1622,6 +1910,10 @@ static void doWizardCommands(char command) {
             // NOTE: every field from the struct needs to be filled correctly
             wizardCreateObjects();
             break;
+        case CTRL_KEY('S'):
+            // Show the timings of the last turns
+            turnStatsDisplay();
+            break;
         default:
             if (config::options::use_roguelike_keys) {
                 putStringClearToEOL("Type '?' or '\\' for help.", Coord_t{0, 0});
@@ -2143,6 +2435,19 @@ static void examineBook() {
     }
 }
 
+static void dungeonPregenerateStairsLevel() {
+    uint8_t tile_id = dg.floor[py.pos.y][py.pos.x].treasure_id;
+    if (tile_id == 0) {
+        return;
+    }
+
+    if (game.treasure.list[tile_id].category_id == TV_UP_STAIR) {
+        dungeonPregenerateLevel(dg.current_level - 1);
+    } else if (game.treasure.list[tile_id].category_id == TV_DOWN_STAIR) {
+        dungeonPregenerateLevel(dg.current_level + 1);
+    }
+}
+
 // Go up one level -RAK-
 static void dungeonGoUpLevel() {
     uint8_t tile_id = dg.floor[py.pos.y][py.pos.x].treasure_id;
@@ -2317,78 +2622,12 @@ static void playDungeon() {
     // Loop until dead,  or new level
     // Exit when `dg.generate_new_level` and `eof_flag` are both set
     do {
-        // Increment turn counter
-        dg.game_turn++;
-
-        // turn over the store contents every, say, 1000 turns
-        if (dg.current_level != 0 && dg.game_turn % 1000 == 0) {
-            storeMaintenance();
-        }
-
-        // Check for creature generation
-        if (randomNumber(config::monsters::MON_CHANCE_OF_NEW) == 1) {
-            monsterPlaceNewWithinDistance(1, config::monsters::MON_MAX_SIGHT, false);
-        }
-
-        playerUpdateLightStatus();
-
-        //
-        // Update counters and messages
-        //
-
-        // Heroism and Super Heroism must precede anything that can damage player
-        playerUpdateHeroStatus();
-
-        int regen_amount = playerFoodConsumption();
-        playerUpdateRegeneration(regen_amount);
-
-        playerUpdateBlindness();
-        playerUpdateConfusion();
-        playerUpdateFearState();
-        playerUpdatePoisonedState();
-        playerUpdateSpeed();
-        playerUpdateRestingState();
-
-        // Check for interrupts to find or rest.
-        int microseconds = (py.running_tracker != 0 ? 0 : 10000);
-        if ((game.command_count > 0 || (py.running_tracker != 0) || py.flags.rest != 0) && checkForNonBlockingKeyPress(microseconds)) {
-            playerDisturb(0, 0);
-        }
-
-        playerUpdateHallucination();
-        playerUpdateParalysis();
-        playerUpdateEvilProtection();
-        playerUpdateInvulnerability();
-        playerUpdateBlessedness();
-        playerUpdateHeatResistance();
-        playerUpdateColdResistance();
-        playerUpdateDetectInvisible();
-        playerUpdateInfraVision();
-        playerUpdateWordOfRecall();
-
-        // Random teleportation
-        if (py.flags.teleport && randomNumber(100) == 1) {
-            playerDisturb(0, 0);
-            playerTeleport(40);
-        }
-
-        // See if we are too weak to handle the weapon or pack. -CJS-
-        if ((py.flags.status & config::player::status::PY_STR_WGT) != 0u) {
-            playerStrength();
-        }
-
-        if ((py.flags.status & config::player::status::PY_STUDY) != 0u) {
-            printCharacterStudyInstruction();
-        }
-
-        playerUpdateStatusFlags();
-
-        // Allow for a slim chance of detect enchantment -CJS-
-        // for 1st level char, check once every 2160 turns
-        // for 40th level char, check once every 416 turns
-        int chance = 10 + 750 / (5 + py.misc.level);
-        if ((dg.game_turn & 0xF) == 0 && py.flags.confused == 0 && randomNumber(chance) == 1) {
-            playerDetectEnchantment();
+        // Resting while every monster is dormant, the turns are played out
+        // in a tight loop for as long as nothing happens on them. The turn
+        // it stops on is finished off here.
+        if (!playerRestQuietly()) {
+            (void) dungeonBeginTurn();
+            playerUpdateStatus();
         }
 
         // Check the state of the monster list, and delete some monsters if
@@ -2396,10 +2635,14 @@ static void playDungeon() {
         // creature.c when monsters try to multiply.  Compact_monsters() is
         // much more likely to succeed if called from here, than if called
         // from within updateMonsters().
-        if (MON_TOTAL_ALLOCATIONS - next_free_monster_id < 10) {
+        if (monsterFreeSlotsTotal() < 10) {
             (void) compactMonsters();
         }
 
+        // While standing on a staircase, have the level it leads to built
+        // in the background, ready for when the player takes it.
+        dungeonPregenerateStairsLevel();
+
         // Accept a command?
         if (py.flags.paralysis < 1 && py.flags.rest == 0 && !game.character_is_dead) {
             executeInputCommands(last_input_command, find_count);
@@ -12,6 +12,7 @@
 #include "version.h"
 
 #include <sstream>
+#include <vector>
 
 // For debugging the save file code on systems with broken compilers.
 #define DEBUG(x)
@@ -21,12 +22,16 @@ DEBUG(static FILE *logfile)
 static bool saveChar(const std::string &filename);
 static bool svWrite();
 
+static void wrSectionStart();
+static bool wrSectionEnd(uint8_t section_id);
+static bool rdSectionStart(uint8_t section_id);
+
 static void wrBool(bool value);
 static void wrByte(uint8_t value);
 static void wrShort(uint16_t value);
 static void wrLong(uint32_t value);
 static void wrBytes(uint8_t *value, int count);
-static void wrString(char *str);
+static void wrString(const char *str);
 static void wrShorts(uint16_t *value, int count);
 
 static void wrItem(Inventory_t &item);
@@ -51,6 +56,41 @@ static uint8_t xor_byte;
 static int from_save_file;   // can overwrite old save file when save
 static uint32_t start_time; // time that play started
 
+// Save files are written as a sequence of sections, each of which is
+// serialised into an in-memory block and written with a single fwrite().
+// Each block restarts the xor_byte encoding, so sections are independent
+// of each other. A section is stored as:
+//
+//   section id (1 byte), data length (4 bytes), data
+//
+// Save files from before this format (see `SAVE_FILE_SIGNATURE`) are a
+// single xor_byte encoded stream and can still be loaded.
+//
+// Format version 2 stores tile creature ids as 16-bit values, and an in
+// use flag ahead of each monster slot, as monster slots may now be free.
+constexpr uint8_t SAVE_FILE_SIGNATURE[] = {'U', 'M', 'S', 'F'};
+constexpr uint8_t SAVE_FILE_FORMAT_VERSION = 2;
+constexpr uint8_t SAVE_SECTION_HEADER_SIZE = 5;
+constexpr uint32_t SAVE_SECTION_MAX_SIZE = 0x100000;
+
+constexpr uint8_t SAVE_SECTION_RECALL = 1;
+constexpr uint8_t SAVE_SECTION_OPTIONS = 2;
+constexpr uint8_t SAVE_SECTION_PLAYER = 3;
+constexpr uint8_t SAVE_SECTION_STORES = 4;
+constexpr uint8_t SAVE_SECTION_GAME = 5;
+constexpr uint8_t SAVE_SECTION_DUNGEON = 6;
+constexpr uint8_t SAVE_SECTION_FLOOR = 7;
+constexpr uint8_t SAVE_SECTION_TREASURE = 8;
+constexpr uint8_t SAVE_SECTION_MONSTERS = 9;
+
+static std::vector<uint8_t> save_block; // data for the section being written
+static uint8_t section_xor_byte = 0;     // starting xor_byte for each written section
+
+static bool block_format = false;       // `true` when loading a block based save file
+static std::vector<uint8_t> load_block; // data for the section being read
+static size_t load_block_pos = 0;
+static bool load_block_overrun = false;
+
 // This save package was brought to by                -JWT-
 // and                                                -RAK-
 // and has been completely rewritten for UNIX by      -JEW-
@@ -130,6 +170,10 @@ static bool svWrite() {
     if (config::options::display_counts) {
         l |= 0x400;
     }
+    // Set when the option is off, so games saved before it existed keep it on.
+    if (!config::options::animate_projectiles) {
+        l |= 0x800;
+    }
     if (game.character_is_dead) {
         // Sign bit
         l |= 0x80000000L;
@@ -138,6 +182,7 @@ static bool svWrite() {
         l |= 0x40000000L;
     }
 
+    wrSectionStart();
     for (int i = 0; i < MON_MAX_CREATURES; i++) {
         Recall_t &r = creature_recall[i];
         if (r.movement || r.defenses || r.kills || r.spells || r.deaths || r.attacks[0] || r.attacks[1] || r.attacks[2] || r.attacks[3]) {
@@ -155,9 +200,17 @@ static bool svWrite() {
 
     // sentinel to indicate no more monster info
     wrShort((uint16_t) 0xFFFF);
+    if (!wrSectionEnd(SAVE_SECTION_RECALL)) {
+        return false;
+    }
 
+    wrSectionStart();
     wrLong(l);
+    if (!wrSectionEnd(SAVE_SECTION_OPTIONS)) {
+        return false;
+    }
 
+    wrSectionStart();
     wrString(py.misc.name);
     wrBool(py.misc.gender);
     wrLong((uint32_t) py.misc.au);
@@ -267,9 +320,11 @@ static bool svWrite() {
     wrBytes(objects_identified, OBJECT_IDENT_SIZE);
     wrLong(game.magic_seed);
     wrLong(game.town_seed);
-    wrShort((uint16_t) last_message_id);
-    for (auto &message : messages) {
-        wrString(message);
+    wrShort((uint16_t) messageHistoryNewestSlot());
+    for (int slot = 0; slot < MESSAGE_HISTORY_SIZE; slot++) {
+        vtype_t text = {'\0'};
+        messageHistorySlotText(slot, text);
+        wrString(text);
     }
 
     // this indicates 'cheating' if it is a one
@@ -277,7 +332,11 @@ static bool svWrite() {
     wrShort((uint16_t) game.total_winner);
     wrShort((uint16_t) game.noscore);
     wrShorts(py.base_hp_levels, PLAYER_MAX_LEVEL);
+    if (!wrSectionEnd(SAVE_SECTION_PLAYER)) {
+        return false;
+    }
 
+    wrSectionStart();
     for (auto &store : stores) {
         wrLong((uint32_t) store.turns_left_before_closing);
         wrShort((uint16_t) store.insults_counter);
@@ -290,6 +349,9 @@ static bool svWrite() {
             wrItem(store.inventory[j].item);
         }
     }
+    if (!wrSectionEnd(SAVE_SECTION_STORES)) {
+        return false;
+    }
 
     // save the current time in the save file
     l = getCurrentUnixTime();
@@ -299,6 +361,7 @@ static bool svWrite() {
         // assume that we have been playing for 1 day
         l = (uint32_t)(start_time + 86400L);
     }
+    wrSectionStart();
     wrLong(l);
 
     // put game.character_died_from string in save file
@@ -310,6 +373,9 @@ static bool svWrite() {
 
     // put the date_of_birth in the save file
     wrLong((uint32_t) py.misc.date_of_birth);
+    if (!wrSectionEnd(SAVE_SECTION_GAME)) {
+        return false;
+    }
 
     // only level specific info follows, this allows characters to be
     // resurrected, the dungeon level info is not needed for a resurrection
@@ -317,6 +383,7 @@ static bool svWrite() {
         return !((ferror(fileptr) != 0) || fflush(fileptr) == EOF);
     }
 
+    wrSectionStart();
     wrShort((uint16_t) dg.current_level);
     wrShort((uint16_t) py.pos.y);
     wrShort((uint16_t) py.pos.x);
@@ -325,13 +392,17 @@ static bool svWrite() {
     wrShort((uint16_t) dg.width);
     wrShort((uint16_t) dg.panel.max_rows);
     wrShort((uint16_t) dg.panel.max_cols);
+    if (!wrSectionEnd(SAVE_SECTION_DUNGEON)) {
+        return false;
+    }
 
+    wrSectionStart();
     for (int i = 0; i < MAX_HEIGHT; i++) {
         for (int j = 0; j < MAX_WIDTH; j++) {
             if (dg.floor[i][j].creature_id != 0) {
                 wrByte((uint8_t) i);
                 wrByte((uint8_t) j);
-                wrByte(dg.floor[i][j].creature_id);
+                wrShort(dg.floor[i][j].creature_id);
             }
         }
     }
@@ -356,8 +427,9 @@ static bool svWrite() {
     int count = 0;
     uint8_t prev_char = 0;
 
-    for (auto &row : dg.floor) {
-        for (auto tile : row) {
+    for (int y = 0; y < MAX_HEIGHT; y++) {
+        for (int x = 0; x < MAX_WIDTH; x++) {
+            Tile_t const &tile = dg.floor[y][x];
             auto char_tmp = (uint8_t)(tile.feature_id | (tile.perma_lit_room << 4) | (tile.field_mark << 5) | (tile.permanent_light << 6) | (tile.temporary_light << 7));
 
             if (char_tmp != prev_char || count == UCHAR_MAX) {
@@ -374,14 +446,31 @@ static bool svWrite() {
     // save last entry
     wrByte((uint8_t) count);
     wrByte(prev_char);
+    if (!wrSectionEnd(SAVE_SECTION_FLOOR)) {
+        return false;
+    }
 
+    wrSectionStart();
     wrShort((uint16_t) game.treasure.current_id);
     for (int i = config::treasure::MIN_TREASURE_LIST_ID; i < game.treasure.current_id; i++) {
         wrItem(game.treasure.list[i]);
     }
+    if (!wrSectionEnd(SAVE_SECTION_TREASURE)) {
+        return false;
+    }
+
+    monsterScheduleRefreshDistances();
+
+    wrSectionStart();
     wrShort((uint16_t) next_free_monster_id);
     for (int i = config::monsters::MON_MIN_INDEX_ID; i < next_free_monster_id; i++) {
-        wrMonster(monsters[i]);
+        wrBool(monsterIsAllocated(i));
+        if (monsterIsAllocated(i)) {
+            wrMonster(monsters[i]);
+        }
+    }
+    if (!wrSectionEnd(SAVE_SECTION_MONSTERS)) {
+        return false;
     }
 
     return !((ferror(fileptr) != 0) || fflush(fileptr) == EOF);
@@ -416,19 +505,21 @@ static bool saveChar(const std::string &filename) {
     DEBUG(fprintf(logfile, "Saving data to %s\n", config::files::save_game))
 
     if (fileptr != nullptr) {
-        xor_byte = 0;
-        wrByte(CURRENT_VERSION_MAJOR);
-        xor_byte = 0;
-        wrByte(CURRENT_VERSION_MINOR);
-        xor_byte = 0;
-        wrByte(CURRENT_VERSION_PATCH);
-        xor_byte = 0;
-
-        auto char_tmp = (uint8_t)(randomNumber(256) - 1);
-        wrByte(char_tmp);
-        // Note that xor_byte is now equal to char_tmp
-
-        ok = svWrite();
+        uint8_t header[] = {
+            SAVE_FILE_SIGNATURE[0],
+            SAVE_FILE_SIGNATURE[1],
+            SAVE_FILE_SIGNATURE[2],
+            SAVE_FILE_SIGNATURE[3],
+            SAVE_FILE_FORMAT_VERSION,
+            CURRENT_VERSION_MAJOR,
+            CURRENT_VERSION_MINOR,
+            CURRENT_VERSION_PATCH,
+        };
+
+        // each section starts its xor_byte encoding from this value
+        section_xor_byte = (uint8_t)(randomNumber(256) - 1);
+
+        ok = fwrite(header, sizeof(header), 1, fileptr) == 1 && svWrite();
 
         DEBUG(fclose(logfile))
 
@@ -461,12 +552,13 @@ static bool saveChar(const std::string &filename) {
 
 // Certain checks are omitted for the wizard. -CJS-
 bool loadGame(bool &generate) {
-    Tile_t *tile = nullptr;
+    uint8_t signature[sizeof(SAVE_FILE_SIGNATURE)];
     int c;
     uint32_t time_saved = 0;
     uint8_t version_maj = 0;
     uint8_t version_min = 0;
     uint8_t patch_level = 0;
+    uint8_t format_version = 0;
 
     generate = true;
     int fd = -1;
@@ -511,15 +603,32 @@ bool loadGame(bool &generate) {
         DEBUG(logfile = fopen("IO_LOG", "a"))
         DEBUG(fprintf(logfile, "Reading data from %s\n", config::files::save_game))
 
-        // Note: setting these xor_byte is correct!
-        xor_byte = 0;
-        version_maj = rdByte();
-        xor_byte = 0;
-        version_min = rdByte();
-        xor_byte = 0;
-        patch_level = rdByte();
+        load_block_overrun = false;
+        block_format = fread(signature, sizeof(signature), 1, fileptr) == 1 && memcmp(signature, SAVE_FILE_SIGNATURE, sizeof(signature)) == 0;
 
-        xor_byte = getByte();
+        if (block_format) {
+            // format version, followed by the game version
+            if (fread(signature, sizeof(signature), 1, fileptr) != 1 || signature[0] > SAVE_FILE_FORMAT_VERSION) {
+                goto error;
+            }
+            format_version = signature[0];
+            version_maj = signature[1];
+            version_min = signature[2];
+            patch_level = signature[3];
+        } else {
+            // A legacy save file, which starts with the version number
+            rewind(fileptr);
+
+            // Note: setting these xor_byte is correct!
+            xor_byte = 0;
+            version_maj = rdByte();
+            xor_byte = 0;
+            version_min = rdByte();
+            xor_byte = 0;
+            patch_level = rdByte();
+
+            xor_byte = getByte();
+        }
 
         if (!validGameVersion(version_maj, version_min, patch_level)) {
             putStringClearToEOL("Sorry. This save file is from a different version of umoria.", Coord_t{2, 0});
@@ -529,6 +638,9 @@ bool loadGame(bool &generate) {
         uint16_t uint_16_t_tmp;
         uint32_t l;
 
+        if (!rdSectionStart(SAVE_SECTION_RECALL)) {
+            goto error;
+        }
         uint_16_t_tmp = rdShort();
         while (uint_16_t_tmp != 0xFFFF) {
             if (uint_16_t_tmp >= MON_MAX_CREATURES) {
@@ -546,6 +658,9 @@ bool loadGame(bool &generate) {
             uint_16_t_tmp = rdShort();
         }
 
+        if (!rdSectionStart(SAVE_SECTION_OPTIONS)) {
+            goto error;
+        }
         l = rdLong();
 
         config::options::run_cut_corners = (l & 0x1) != 0;
@@ -559,6 +674,7 @@ bool loadGame(bool &generate) {
         config::options::run_ignore_doors = (l & 0x100) != 0;
         config::options::error_beep_sound = (l & 0x200) != 0;
         config::options::display_counts = (l & 0x400) != 0;
+        config::options::animate_projectiles = (l & 0x800) == 0;
 
         // Don't allow resurrection of game.total_winner characters.  It causes
         // problems because the character level is out of the allowed range.
@@ -570,6 +686,9 @@ bool loadGame(bool &generate) {
         }
 
         if ((l & 0x80000000L) == 0) {
+            if (!rdSectionStart(SAVE_SECTION_PLAYER)) {
+                goto error;
+            }
             rdString(py.misc.name);
             py.misc.gender = rdBool();
             py.misc.au = rdLong();
@@ -682,10 +801,12 @@ bool loadGame(bool &generate) {
             rdBytes(objects_identified, OBJECT_IDENT_SIZE);
             game.magic_seed = rdLong();
             game.town_seed = rdLong();
-            last_message_id = rdShort();
-            for (auto &message : messages) {
+            int newest_message_slot = rdShort() % MESSAGE_HISTORY_SIZE;
+            vtype_t message_texts[MESSAGE_HISTORY_SIZE];
+            for (auto &message : message_texts) {
                 rdString(message);
             }
+            messageHistoryRestore(newest_message_slot, message_texts);
 
             uint16_t panic_save_short;
             uint16_t total_winner_short;
@@ -697,6 +818,9 @@ bool loadGame(bool &generate) {
             game.noscore = rdShort();
             rdShorts(py.base_hp_levels, PLAYER_MAX_LEVEL);
 
+            if (!rdSectionStart(SAVE_SECTION_STORES)) {
+                goto error;
+            }
             for (auto &store : stores) {
                 store.turns_left_before_closing = rdLong();
                 store.insults_counter = rdShort();
@@ -713,6 +837,9 @@ bool loadGame(bool &generate) {
                 }
             }
 
+            if (!rdSectionStart(SAVE_SECTION_GAME)) {
+                goto error;
+            }
             time_saved = rdLong();
             rdString(game.character_died_from);
             py.max_score = rdLong();
@@ -766,6 +893,9 @@ bool loadGame(bool &generate) {
         // only level specific info should follow,
         // not present for dead characters
 
+        if (!rdSectionStart(SAVE_SECTION_DUNGEON)) {
+            goto error;
+        }
         dg.current_level = rdShort();
         py.pos.y = rdShort();
         py.pos.x = rdShort();
@@ -777,16 +907,20 @@ bool loadGame(bool &generate) {
 
         uint8_t char_tmp, ychar, xchar, count;
 
-        // read in the creature ptr info
+        if (!rdSectionStart(SAVE_SECTION_FLOOR)) {
+            goto error;
+        }
+
+        // read in the creature ptr info, the ids are 16-bit from format version 2
         char_tmp = rdByte();
         while (char_tmp != 0xFF) {
             ychar = char_tmp;
             xchar = rdByte();
-            char_tmp = rdByte();
-            if (xchar > MAX_WIDTH || ychar > MAX_HEIGHT) {
+            uint_16_t_tmp = format_version >= 2 ? rdShort() : rdByte();
+            if (xchar > MAX_WIDTH || ychar > MAX_HEIGHT || uint_16_t_tmp >= MON_TOTAL_ALLOCATIONS) {
                 goto error;
             }
-            dg.floor[ychar][xchar].creature_id = char_tmp;
+            dg.floor[ychar][xchar].creature_id = uint_16_t_tmp;
             char_tmp = rdByte();
         }
 
@@ -804,25 +938,28 @@ bool loadGame(bool &generate) {
         }
 
         // read in the rest of the cave info
-        tile = &dg.floor[0][0];
         total_count = 0;
         while (total_count != MAX_HEIGHT * MAX_WIDTH) {
             count = rdByte();
             char_tmp = rdByte();
+            if (total_count + count > MAX_HEIGHT * MAX_WIDTH) {
+                goto error;
+            }
             for (int i = count; i > 0; i--) {
-                if (tile >= &dg.floor[MAX_HEIGHT][0]) {
-                    goto error;
-                }
-                tile->feature_id = (uint8_t)(char_tmp & 0xF);
-                tile->perma_lit_room = (bool) ((char_tmp >> 4) & 0x1);
-                tile->field_mark = (bool) ((char_tmp >> 5) & 0x1);
-                tile->permanent_light = (bool) ((char_tmp >> 6) & 0x1);
-                tile->temporary_light = (bool) ((char_tmp >> 7) & 0x1);
-                tile++;
+                Tile_t tile = dg.floor[total_count / MAX_WIDTH][total_count % MAX_WIDTH];
+                tile.feature_id = (uint8_t)(char_tmp & 0xF);
+                tile.perma_lit_room = (bool) ((char_tmp >> 4) & 0x1);
+                tile.field_mark = (bool) ((char_tmp >> 5) & 0x1);
+                tile.permanent_light = (bool) ((char_tmp >> 6) & 0x1);
+                tile.temporary_light = (bool) ((char_tmp >> 7) & 0x1);
+                total_count++;
             }
-            total_count += count;
         }
+        dg.floor.rebuildRooms();
 
+        if (!rdSectionStart(SAVE_SECTION_TREASURE)) {
+            goto error;
+        }
         game.treasure.current_id = rdShort();
         if (game.treasure.current_id > LEVEL_MAX_OBJECTS) {
             goto error;
@@ -830,17 +967,29 @@ bool loadGame(bool &generate) {
         for (int i = config::treasure::MIN_TREASURE_LIST_ID; i < game.treasure.current_id; i++) {
             rdItem(game.treasure.list[i]);
         }
-        next_free_monster_id = rdShort();
-        if (next_free_monster_id > MON_TOTAL_ALLOCATIONS) {
+        if (!rdSectionStart(SAVE_SECTION_MONSTERS)) {
             goto error;
         }
-        for (int i = config::monsters::MON_MIN_INDEX_ID; i < next_free_monster_id; i++) {
+        // from format version 2 there may be free slots among the
+        // monsters, each slot is preceded by an in use flag
+        monsterResetSlots();
+        uint_16_t_tmp = rdShort();
+        if (uint_16_t_tmp > MON_TOTAL_ALLOCATIONS) {
+            goto error;
+        }
+        for (int i = config::monsters::MON_MIN_INDEX_ID; i < uint_16_t_tmp; i++) {
+            if (format_version >= 2 && !rdBool()) {
+                continue;
+            }
+            monsterClaimSlot(i);
             rdMonster(monsters[i]);
         }
+        monsterIndexRebuild();
+        monsterScheduleRebuild();
 
         generate = false; // We have restored a cave - no need to generate.
 
-        if (ferror(fileptr) != 0) {
+        if (ferror(fileptr) != 0 || load_block_overrun) {
             goto error;
         }
 
@@ -859,6 +1008,8 @@ bool loadGame(bool &generate) {
 
         DEBUG(fclose(logfile));
 
+        block_format = false;
+
         if (fileptr != nullptr) {
             if (fclose(fileptr) < 0) {
                 ok = false;
@@ -936,37 +1087,89 @@ bool loadGame(bool &generate) {
     return false; // not reached
 }
 
+// Start collecting the data for a new save file section.
+static void wrSectionStart() {
+    // reserve space for the section header
+    save_block.assign(SAVE_SECTION_HEADER_SIZE, 0);
+
+    xor_byte = 0;
+    wrByte(section_xor_byte);
+    // Note that xor_byte is now equal to section_xor_byte
+}
+
+// Write the collected section data to the save file.
+static bool wrSectionEnd(uint8_t section_id) {
+    auto size = (uint32_t)(save_block.size() - SAVE_SECTION_HEADER_SIZE);
+
+    save_block[0] = section_id;
+    save_block[1] = (uint8_t)(size & 0xFF);
+    save_block[2] = (uint8_t)((size >> 8) & 0xFF);
+    save_block[3] = (uint8_t)((size >> 16) & 0xFF);
+    save_block[4] = (uint8_t)((size >> 24) & 0xFF);
+
+    return fwrite(save_block.data(), save_block.size(), 1, fileptr) == 1;
+}
+
+// Read the next section of a block based save file into memory, from
+// which all following rd*() calls will decode their data. For a legacy
+// save file this does nothing, as it is read directly from the file.
+static bool rdSectionStart(uint8_t section_id) {
+    if (!block_format) {
+        return true;
+    }
+
+    uint8_t header[SAVE_SECTION_HEADER_SIZE];
+    if (fread(header, sizeof(header), 1, fileptr) != 1 || header[0] != section_id) {
+        return false;
+    }
+
+    uint32_t size = header[1] | (header[2] << 8) | (header[3] << 16) | ((uint32_t) header[4] << 24);
+    if (size == 0 || size > SAVE_SECTION_MAX_SIZE) {
+        return false;
+    }
+
+    load_block.resize(size);
+    if (fread(load_block.data(), size, 1, fileptr) != 1) {
+        return false;
+    }
+    load_block_pos = 0;
+
+    xor_byte = getByte();
+
+    return true;
+}
+
 static void wrBool(bool value) {
     wrByte((uint8_t) value);
 }
 
 static void wrByte(uint8_t value) {
     xor_byte ^= value;
-    (void) putc((int) xor_byte, fileptr);
+    save_block.push_back(xor_byte);
     DEBUG(fprintf(logfile, "BYTE:  %02X = %d\n", (int) xor_byte, (int) value))
 }
 
 static void wrShort(uint16_t value) {
     xor_byte ^= (value & 0xFF);
-    (void) putc((int) xor_byte, fileptr);
+    save_block.push_back(xor_byte);
     DEBUG(fprintf(logfile, "SHORT: %02X", (int) xor_byte))
     xor_byte ^= ((value >> 8) & 0xFF);
-    (void) putc((int) xor_byte, fileptr);
+    save_block.push_back(xor_byte);
     DEBUG(fprintf(logfile, " %02X = %d\n", (int) xor_byte, (int) value))
 }
 
 static void wrLong(uint32_t value) {
     xor_byte ^= (value & 0xFF);
-    (void) putc((int) xor_byte, fileptr);
+    save_block.push_back(xor_byte);
     DEBUG(fprintf(logfile, "LONG:  %02X", (int) xor_byte))
     xor_byte ^= ((value >> 8) & 0xFF);
-    (void) putc((int) xor_byte, fileptr);
+    save_block.push_back(xor_byte);
     DEBUG(fprintf(logfile, " %02X", (int) xor_byte))
     xor_byte ^= ((value >> 16) & 0xFF);
-    (void) putc((int) xor_byte, fileptr);
+    save_block.push_back(xor_byte);
     DEBUG(fprintf(logfile, " %02X", (int) xor_byte))
     xor_byte ^= ((value >> 24) & 0xFF);
-    (void) putc((int) xor_byte, fileptr);
+    save_block.push_back(xor_byte);
     DEBUG(fprintf(logfile, " %02X = %ld\n", (int) xor_byte, (int32_t) value))
 }
 
@@ -977,22 +1180,22 @@ static void wrBytes(uint8_t *value, int count) {
     ptr = value;
     for (int i = 0; i < count; i++) {
         xor_byte ^= *ptr++;
-        (void) putc((int) xor_byte, fileptr);
+        save_block.push_back(xor_byte);
         DEBUG(fprintf(logfile, "  %02X = %d", (int) xor_byte, (int) (ptr[-1])))
     }
     DEBUG(fprintf(logfile, "\n"))
 }
 
-static void wrString(char *str) {
-    DEBUG(char *s = str)
+static void wrString(const char *str) {
+    DEBUG(const char *s = str)
     DEBUG(fprintf(logfile, "STRING:"))
     while (*str != '\0') {
         xor_byte ^= *str++;
-        (void) putc((int) xor_byte, fileptr);
+        save_block.push_back(xor_byte);
         DEBUG(fprintf(logfile, " %02X", (int) xor_byte))
     }
     xor_byte ^= *str;
-    (void) putc((int) xor_byte, fileptr);
+    save_block.push_back(xor_byte);
     DEBUG(fprintf(logfile, " %02X = \"%s\"\n", (int) xor_byte, s))
 }
 
@@ -1003,10 +1206,10 @@ static void wrShorts(uint16_t *value, int count) {
 
     for (int i = 0; i < count; i++) {
         xor_byte ^= (*sptr & 0xFF);
-        (void) putc((int) xor_byte, fileptr);
+        save_block.push_back(xor_byte);
         DEBUG(fprintf(logfile, "  %02X", (int) xor_byte))
         xor_byte ^= ((*sptr++ >> 8) & 0xFF);
-        (void) putc((int) xor_byte, fileptr);
+        save_block.push_back(xor_byte);
         DEBUG(fprintf(logfile, " %02X = %d", (int) xor_byte, (int) sptr[-1]))
     }
     DEBUG(fprintf(logfile, "\n"))
@@ -1049,8 +1252,17 @@ static void wrMonster(Monster_t const &monster) {
     wrByte(monster.confused_amount);
 }
 
-// get_byte reads a single byte from a file, without any xor_byte encryption
+// get_byte reads a single byte from a file, or the current save file
+// section, without any xor_byte encryption
 static uint8_t getByte() {
+    if (block_format) {
+        if (load_block_pos >= load_block.size()) {
+            load_block_overrun = true;
+            return 0;
+        }
+        return load_block[load_block_pos++];
+    }
+
     return (uint8_t)(getc(fileptr) & 0xFF);
 }
 
@@ -1181,29 +1393,6 @@ void setFileptr(FILE *file) {
     fileptr = file;
 }
 
-void saveHighScore(HighScore_t const &score) {
-    DEBUG(logfile = fopen("IO_LOG", "a"))
-    DEBUG(fprintf(logfile, "Saving score:\n"))
-
-    // Save the encryption byte for robustness.
-    wrByte(xor_byte);
-
-    wrLong((uint32_t) score.points);
-    wrLong((uint32_t) score.birth_date);
-    wrShort((uint16_t) score.uid);
-    wrShort((uint16_t) score.mhp);
-    wrShort((uint16_t) score.chp);
-    wrByte(score.dungeon_depth);
-    wrByte(score.level);
-    wrByte(score.deepest_dungeon_depth);
-    wrByte(score.gender);
-    wrByte(score.race);
-    wrByte(score.character_class);
-    wrBytes((uint8_t *) score.name, PLAYER_NAME_SIZE);
-    wrBytes((uint8_t *) score.died_from, 25);
-    DEBUG(fclose(logfile))
-}
-
 void readHighScore(HighScore_t &score) {
     DEBUG(logfile = fopen("IO_LOG", "a"))
     DEBUG(fprintf(logfile, "Reading score:\n"))
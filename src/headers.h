@@ -25,7 +25,10 @@
 
     #include <pwd.h>
     #include <unistd.h>
+    #include <signal.h>
+    #include <sys/mman.h>
     #include <sys/param.h>
+    #include <sys/wait.h>
 
 #else
 #   error "Unknown compiler"
@@ -63,9 +66,11 @@
 #include "helpers.h"
 #include "identification.h"
 #include "mage_spells.h"
+#include "message_history.h"
 #include "monster.h"
 #include "player.h"
 #include "recall.h"
+#include "replay.h"
 #include "rng.h"
 #include "scores.h"
 #include "scrolls.h"
@@ -73,4 +78,5 @@
 #include "staves.h"
 #include "store.h"
 #include "treasure.h"
+#include "turn_stats.h"
 #include "wizard.h"
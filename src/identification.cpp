@@ -233,7 +233,9 @@ void identifyGameObject() {
 void magicInitializeItemNames() {
     int id;
 
-    seedSet(game.magic_seed);
+    // the same names every time the game is loaded
+    Rng_t magic_rng(game.magic_seed);
+    RngStreamScope_t magic_rng_scope(magic_rng);
 
     // The first 3 entries for colors are fixed, (slime & apple juice, water)
     for (int i = 3; i < MAX_COLORS; i++) {
@@ -302,8 +304,6 @@ void magicInitializeItemNames() {
 
         (void) strcpy(item_title, title);
     }
-
-    seedResetToOldSeed();
 }
 
 int16_t objectPositionOffset(int category_id, int sub_category_id) {
@@ -12,6 +12,7 @@
 #include "version.h"
 
 static bool parseGameSeed(const char *argv, uint32_t &seed);
+static bool parseGameTurn(const char *argv, int32_t &turn);
 
 #ifdef XCODE_DEBUG
 bool prepare_stdin_for_debugger(int timeout_ms);
@@ -27,6 +28,13 @@ Options:
     -n           Force start of new game
     -d           Display high scores and exit
     -s NUMBER    Game Seed, as a decimal number (max: 2147483647)
+    -b FILE      Batch mode: run without a terminal, reading key presses
+                 from FILE (use - for stdin)
+    -r FILE      Record a replay of a new game to FILE
+    --replay FILE
+                 Play back a replay recorded with -r, without a terminal,
+                 then carry on playing the game from where it ends
+    -t TURN      Stop playing back the replay at game turn TURN
 
     -v           Print version info and exit
     -h           Display this message
@@ -41,6 +49,11 @@ int main(int argc, char *argv[]) {
 #endif
     uint32_t seed = 0;
     bool new_game = false;
+    bool display_scores = false;
+    const char *batch_file = nullptr;
+    const char *record_file = nullptr;
+    const char *replay_file = nullptr;
+    int32_t replay_stop_turn = -1;
 
     // call this routine to grab a file pointer to the high score file
     // and prepare things to relinquish setuid privileges
@@ -54,23 +67,17 @@ int main(int argc, char *argv[]) {
         return 1;
     }
 
-    if (!terminalInitialize()) {
-        return 1;
-    }
-
     // check for user interface option
     for (--argc, ++argv; argc > 0 && argv[0][0] == '-'; --argc, ++argv) {
         switch (argv[0][1]) {
             case 'v':
-                terminalRestore();
                 printf("%d.%d.%d\n", CURRENT_VERSION_MAJOR, CURRENT_VERSION_MINOR, CURRENT_VERSION_PATCH);
                 return 0;
             case 'n':
                 new_game = true;
                 break;
             case 'd':
-                showScoresScreen();
-                exitProgram();
+                display_scores = true;
                 break;
             case 's':
                 // No NUMBER provided?
@@ -83,18 +90,67 @@ int main(int argc, char *argv[]) {
                 ++argv;
 
                 if (!parseGameSeed(argv[0], seed)) {
-                    terminalRestore();
                     printf("Game seed must be a decimal number between 1 and 2147483647\n");
                     return -1;
                 }
 
                 break;
+            case 'b':
+                // No FILE provided?
+                if (argv[1] == nullptr) {
+                    break;
+                }
+
+                // Move onto the FILE value
+                --argc;
+                ++argv;
+
+                batch_file = argv[0];
+                break;
+            case 'r':
+                // No FILE provided?
+                if (argv[1] == nullptr) {
+                    break;
+                }
+
+                // Move onto the FILE value
+                --argc;
+                ++argv;
+
+                record_file = argv[0];
+                break;
+            case 't':
+                // No TURN provided?
+                if (argv[1] == nullptr) {
+                    break;
+                }
+
+                // Move onto the TURN value
+                --argc;
+                ++argv;
+
+                if (!parseGameTurn(argv[0], replay_stop_turn)) {
+                    printf("Game turn must be a decimal number between 0 and 2147483647\n");
+                    return -1;
+                }
+
+                break;
+            case '-':
+                if (strcmp(argv[0], "--replay") == 0 && argv[1] != nullptr) {
+                    // Move onto the FILE value
+                    --argc;
+                    ++argv;
+
+                    replay_file = argv[0];
+                    break;
+                }
+
+                printf("%s", usage_instructions);
+                return 0;
             case 'w':
                 game.to_be_wizard = true;
                 break;
             default:
-                terminalRestore();
-
                 printf("Robert A. Koeneke's classic dungeon crawler.\n");
                 printf("Umoria %d.%d.%d is released under a GPL v2 license.\n", CURRENT_VERSION_MAJOR, CURRENT_VERSION_MINOR, CURRENT_VERSION_PATCH);
                 printf("%s", usage_instructions);
@@ -102,6 +158,38 @@ int main(int argc, char *argv[]) {
         }
     }
 
+    if (record_file != nullptr) {
+        // the replay needs the seed, so take it from the clock
+        // now, rather than leaving that to seedsInitialize()
+        if (seed == 0) {
+            seed = getCurrentUnixTime();
+        }
+
+        if (!replayStartRecording(record_file, seed, game.to_be_wizard, batch_file != nullptr)) {
+            printf("Can't create replay file '%s'.\n", record_file);
+            return 1;
+        }
+    }
+
+    if (replay_file != nullptr) {
+        if (!replayStartPlayback(replay_file, replay_stop_turn, seed, game.to_be_wizard)) {
+            printf("Can't play back replay file '%s'.\n", replay_file);
+            return 1;
+        }
+        new_game = true;
+    } else if (batch_file != nullptr) {
+        if (!terminalInitializeBatchMode(batch_file)) {
+            return 1;
+        }
+    } else if (!terminalInitialize()) {
+        return 1;
+    }
+
+    if (display_scores) {
+        showScoresScreen();
+        exitProgram();
+    }
+
     // Auto-restart of saved file
     if (argv[0] != CNIL) {
         // (void) strcpy(config::files::save_game, argv[0]);
@@ -128,6 +216,21 @@ static bool parseGameSeed(const char *argv, uint32_t &seed) {
     return true;
 }
 
+static bool parseGameTurn(const char *argv, int32_t &turn) {
+    int value;
+
+    if (!stringToNumber(argv, value)) {
+        return false;
+    }
+    if (value < 0) {
+        return false;
+    }
+
+    turn = (int32_t) value;
+
+    return true;
+}
+
 #ifdef XCODE_DEBUG
 // Workaround for allowing the debugger to reliably attach to the umoria process when launched from Xcode.
 // https://stackoverflow.com/a/31971610
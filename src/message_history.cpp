@@ -0,0 +1,270 @@
+// Copyright (c) 1981-86 Robert A. Koeneke
+// Copyright (c) 1987-94 James E. Wilson
+//
+// This work is free software released under the GNU General Public License
+// version 2.0, and comes with ABSOLUTELY NO WARRANTY.
+//
+// See LICENSE and AUTHORS for more information.
+
+// The message history, the last messages printed to the message line
+
+#include "headers.h"
+#include <atomic>
+
+// The messages are numbered in sequence, and message `sequence` is kept in
+// slot `sequence % MESSAGE_HISTORY_SIZE` of the ring, so the ring needs no
+// index of its own, and anything following the messages can tell which of
+// them it has yet to see, and which it has missed.
+//
+// The numbering starts with the empty message in slot 0 numbered
+// MESSAGE_HISTORY_SIZE, so that every slot holds a numbered message, even
+// if only an empty one.
+//
+// Only the game adds messages. A reader on another thread, such as a log
+// of the game, copies them out with messageHistoryRead(), which never holds
+// the game up: it fails if the ring was written to while it copied, and
+// can be tried again. So that the copy is never a data race, each record
+// is kept as words which are only read and written atomically.
+constexpr int MESSAGE_RECORD_WORDS = (sizeof(MessageRecord_t) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+static std::atomic<uint64_t> message_history[MESSAGE_HISTORY_SIZE][MESSAGE_RECORD_WORDS];
+static std::atomic<uint32_t> message_history_newest{MESSAGE_HISTORY_SIZE};
+
+// Odd while the ring is being written to.
+static std::atomic<uint32_t> message_history_writes{0};
+
+static void messageHistoryBeginWrite() {
+    message_history_writes.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+static void messageHistoryEndWrite() {
+    message_history_writes.fetch_add(1, std::memory_order_release);
+}
+
+static void messageHistoryLoad(int slot, MessageRecord_t &record) {
+    uint64_t words[MESSAGE_RECORD_WORDS];
+
+    for (int word = 0; word < MESSAGE_RECORD_WORDS; word++) {
+        words[word] = message_history[slot][word].load(std::memory_order_relaxed);
+    }
+
+    (void) memcpy(&record, words, sizeof(record));
+}
+
+static void messageHistoryStore(int slot, MessageRecord_t const &record) {
+    uint64_t words[MESSAGE_RECORD_WORDS] = {0};
+    (void) memcpy(words, &record, sizeof(record));
+
+    for (int word = 0; word < MESSAGE_RECORD_WORDS; word++) {
+        message_history[slot][word].store(words[word], std::memory_order_relaxed);
+    }
+}
+
+// Copies as much of `msg` as fits onto the end of `text`, which is
+// `length` long.
+static void messageCopy(vtype_t text, int &length, const char *msg) {
+    while (*msg != '\0' && length < MORIA_MESSAGE_SIZE - 1) {
+        text[length++] = *msg++;
+    }
+    text[length] = '\0';
+}
+
+// Makes the text of a message from `format`, in which "%d" is replaced by
+// the next parameter as a number, "%m" by the next parameter as a monster:
+// "the Kobold", or "it" for MESSAGE_UNSEEN_MONSTER, and "%M" by the same
+// with a capital letter. Only the creature list is read, so the text of a
+// message can be made on any thread.
+void messageFormat(const char *format, int32_t const params[MESSAGE_PARAMS_MAX], vtype_t text) {
+    int length = 0;
+    int param = 0;
+
+    text[0] = '\0';
+
+    for (const char *c = format; *c != '\0'; c++) {
+        if (*c != '%' || c[1] == '\0') {
+            char character[2] = {*c, '\0'};
+            messageCopy(text, length, character);
+            continue;
+        }
+
+        c++;
+
+        int32_t value = param < MESSAGE_PARAMS_MAX ? params[param] : 0;
+
+        if (*c == 'd') {
+            param++;
+
+            char number[12];
+            (void) sprintf(number, "%d", (int) value);
+            messageCopy(text, length, number);
+        } else if (*c == 'm' || *c == 'M') {
+            param++;
+
+            if (value >= 0 && value < MON_MAX_CREATURES) {
+                messageCopy(text, length, *c == 'M' ? "The " : "the ");
+                messageCopy(text, length, creatures_list[value].name);
+            } else {
+                messageCopy(text, length, *c == 'M' ? "It" : "it");
+            }
+        } else {
+            char character[2] = {*c, '\0'};
+            messageCopy(text, length, character);
+        }
+    }
+}
+
+// The text of the message in `record`, made from its format if it has
+// not been made yet.
+void messageRecordText(MessageRecord_t const &record, vtype_t text) {
+    if (record.formatted || record.format == nullptr) {
+        (void) memcpy(text, record.text, sizeof(vtype_t));
+        text[MORIA_MESSAGE_SIZE - 1] = '\0';
+    } else {
+        messageFormat(record.format, record.params, text);
+    }
+}
+
+// Keep `msg` as the newest message.
+void messageHistoryAdd(const char *msg) {
+    messageHistoryAddFormat(MessageSource::General, nullptr, nullptr, msg);
+}
+
+// Keep the message made from `format` and `params` as the newest message.
+// `msg` is its text, when it has been made already, otherwise nullptr, and
+// the text is left to be made when it is read.
+void messageHistoryAddFormat(MessageSource source, const char *format, int32_t const params[MESSAGE_PARAMS_MAX], const char *msg) {
+    uint32_t sequence = message_history_newest.load(std::memory_order_relaxed) + 1;
+
+    MessageRecord_t record{};
+    record.sequence = sequence;
+    record.game_turn = dg.game_turn;
+    record.source = source;
+    record.format = format;
+
+    if (params != nullptr) {
+        for (int i = 0; i < MESSAGE_PARAMS_MAX; i++) {
+            record.params[i] = params[i];
+        }
+    }
+
+    if (msg != nullptr) {
+        int length = 0;
+        messageCopy(record.text, length, msg);
+        record.length = (uint8_t) length;
+        record.formatted = true;
+    }
+
+    messageHistoryBeginWrite();
+
+    messageHistoryStore((int) (sequence % MESSAGE_HISTORY_SIZE), record);
+    message_history_newest.store(sequence, std::memory_order_relaxed);
+
+    messageHistoryEndWrite();
+}
+
+// Add `msg` to the newest message, for when the two are shown on one line.
+void messageHistoryAppend(const char *msg) {
+    int slot = messageHistoryNewestSlot();
+
+    MessageRecord_t record{};
+    messageHistoryLoad(slot, record);
+
+    vtype_t text = {'\0'};
+    messageRecordText(record, text);
+
+    int length = (int) strlen(text);
+    messageCopy(text, length, "  ");
+    messageCopy(text, length, msg);
+
+    // The text is no longer what the format alone would make.
+    (void) memcpy(record.text, text, sizeof(vtype_t));
+    record.length = (uint8_t) length;
+    record.formatted = true;
+    record.format = nullptr;
+
+    messageHistoryBeginWrite();
+    messageHistoryStore(slot, record);
+    messageHistoryEndWrite();
+}
+
+uint32_t messageHistoryNewest() {
+    return message_history_newest.load(std::memory_order_acquire);
+}
+
+// Only for the game, as it is the one writing the messages.
+uint8_t messageHistoryNewestLength() {
+    MessageRecord_t record{};
+    messageHistoryLoad(messageHistoryNewestSlot(), record);
+
+    if (record.formatted) {
+        return record.length;
+    }
+
+    vtype_t text = {'\0'};
+    messageRecordText(record, text);
+
+    return (uint8_t) strlen(text);
+}
+
+// Copies message `sequence` into `record`. Returns false if the message is
+// not in the history, being either too old or not yet printed, or if it
+// could not be copied without being written to at the same time.
+bool messageHistoryRead(uint32_t sequence, MessageRecord_t &record) {
+    uint32_t writes = message_history_writes.load(std::memory_order_acquire);
+    if ((writes & 1) != 0) {
+        return false;
+    }
+
+    uint32_t newest = message_history_newest.load(std::memory_order_relaxed);
+    if (sequence > newest || newest - sequence >= MESSAGE_HISTORY_SIZE) {
+        return false;
+    }
+
+    messageHistoryLoad((int) (sequence % MESSAGE_HISTORY_SIZE), record);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (message_history_writes.load(std::memory_order_relaxed) != writes) {
+        return false;
+    }
+
+    record.sequence = sequence;
+
+    return true;
+}
+
+int messageHistoryNewestSlot() {
+    return (int) (message_history_newest.load(std::memory_order_relaxed) % MESSAGE_HISTORY_SIZE);
+}
+
+void messageHistorySlotText(int slot, vtype_t text) {
+    MessageRecord_t record{};
+    messageHistoryLoad(slot, record);
+    messageRecordText(record, text);
+}
+
+// Restore the history from a saved game, which only keeps the text of
+// each slot, so the turns the messages were printed on are lost.
+void messageHistoryRestore(int newest_slot, vtype_t const texts[MESSAGE_HISTORY_SIZE]) {
+    uint32_t newest = MESSAGE_HISTORY_SIZE + (uint32_t) newest_slot;
+
+    messageHistoryBeginWrite();
+
+    for (int slot = 0; slot < MESSAGE_HISTORY_SIZE; slot++) {
+        MessageRecord_t record{};
+
+        // the numbers of the messages up to the newest one
+        record.sequence = newest - (uint32_t) ((newest_slot - slot + MESSAGE_HISTORY_SIZE) % MESSAGE_HISTORY_SIZE);
+
+        int length = 0;
+        messageCopy(record.text, length, texts[slot]);
+        record.length = (uint8_t) length;
+        record.formatted = true;
+
+        messageHistoryStore(slot, record);
+    }
+
+    message_history_newest.store(newest, std::memory_order_relaxed);
+
+    messageHistoryEndWrite();
+}
@@ -0,0 +1,55 @@
+// Copyright (c) 1981-86 Robert A. Koeneke
+// Copyright (c) 1987-94 James E. Wilson
+//
+// This work is free software released under the GNU General Public License
+// version 2.0, and comes with ABSOLUTELY NO WARRANTY.
+//
+// See LICENSE and AUTHORS for more information.
+
+#pragma once
+
+// Where a message came from.
+enum class MessageSource : uint8_t {
+    General,   // any message printed as a ready made string
+    Combat,    // blows between the player and a monster
+    Character, // changes to the character, such as gaining a level
+};
+
+constexpr int MESSAGE_PARAMS_MAX = 2;
+
+// A monster message parameter for a monster the player can't see.
+constexpr int32_t MESSAGE_UNSEEN_MONSTER = -1;
+
+// A message printed to the message line, as kept in the message history.
+//
+// A message printed with printMessageFormat() keeps its format and
+// parameters, and its text is only made when it is needed, while one
+// printed as a ready made string only has its text.
+typedef struct {
+    uint32_t sequence;                  // of the message, counting up from the start of the session
+    int32_t game_turn;                  // the turn the message was printed on
+    MessageSource source;               // where the message came from
+    bool formatted;                     // `text` holds the text of the message
+    uint8_t length;                     // of `text` when it is formatted, not counting the terminating '\0'
+    const char *format;                 // see messageFormat(), nullptr when there is only the text
+    int32_t params[MESSAGE_PARAMS_MAX]; // the values for the format
+    vtype_t text;
+} MessageRecord_t;
+
+void messageFormat(const char *format, int32_t const params[MESSAGE_PARAMS_MAX], vtype_t text);
+void messageRecordText(MessageRecord_t const &record, vtype_t text);
+
+void messageHistoryAdd(const char *msg);
+void messageHistoryAddFormat(MessageSource source, const char *format, int32_t const params[MESSAGE_PARAMS_MAX], const char *msg);
+void messageHistoryAppend(const char *msg);
+uint32_t messageHistoryNewest();
+uint8_t messageHistoryNewestLength();
+bool messageHistoryRead(uint32_t sequence, MessageRecord_t &record);
+
+// game_save.cpp keeps the history as the text of each slot of the ring
+int messageHistoryNewestSlot();
+void messageHistorySlotText(int slot, vtype_t text);
+void messageHistoryRestore(int newest_slot, vtype_t const texts[MESSAGE_HISTORY_SIZE]);
+
+// ui_io.cpp
+void printMessageFormat(MessageSource source, const char *format, int32_t first, int32_t second = 0);
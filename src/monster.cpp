@@ -49,7 +49,7 @@ void monsterUpdateVisibility(int monster_id) {
         if (game.wizard_mode) {
             // Wizard sight.
             visible = true;
-        } else if (los(py.pos, monster.pos)) {
+        } else if (losFromPlayer(monster.pos)) {
             visible = monsterIsVisible(monster);
         }
     }
@@ -59,6 +59,7 @@ void monsterUpdateVisibility(int monster_id) {
         if (!monster.lit) {
             playerDisturb(1, 0);
             monster.lit = true;
+            monsterScheduleWake(monster_id);
             dungeonLiteSpot(Coord_t{monster.pos.y, monster.pos.x});
 
             // notify inventoryExecuteCommand()
@@ -256,22 +257,153 @@ static void monsterGetMoveDirection(int monster_id, int *directions) {
     }
 }
 
-static void monsterPrintAttackDescription(char *msg, int attack_id) {
+// Flow map of the number of moves from each tile to the player, capped at
+// MON_MAX_FLOW_DISTANCE. A value of `0` is an unreached tile, otherwise the
+// value is the distance plus one. It is rebuilt on the first monster move
+// after the player moves, or the terrain changes.
+static uint8_t flow_distance[MAX_HEIGHT][MAX_WIDTH];
+static Coord_t flow_origin = Coord_t{-1, -1};
+static uint32_t flow_opacity_changes = 0;
+
+// Can a monster path through the tile -- open floor, or a door it may open or bash
+static bool monsterFlowPassable(Coord_t const &coord) {
+    Tile_t const &tile = dg.floor[coord.y][coord.x];
+
+    if (tile.feature_id <= MAX_OPEN_SPACE) {
+        return true;
+    }
+    if (tile.treasure_id == 0) {
+        return false;
+    }
+
+    uint8_t category_id = game.treasure.list[tile.treasure_id].category_id;
+    return category_id == TV_CLOSED_DOOR || category_id == TV_SECRET_DOOR;
+}
+
+// Breadth first search outwards from the player
+static void monsterUpdateFlowMap() {
+    if (flow_origin.y == py.pos.y && flow_origin.x == py.pos.x && flow_opacity_changes == dg.floor.opacity_changes) {
+        return;
+    }
+
+    const int radius = config::monsters::MON_MAX_FLOW_DISTANCE;
+
+    // Only the area around the last origin can have been reached
+    if (flow_origin.y >= 0) {
+        int left = std::max(flow_origin.x - radius, 0);
+        int right = std::min(flow_origin.x + radius, MAX_WIDTH - 1);
+
+        for (int y = std::max(flow_origin.y - radius, 0); y <= std::min(flow_origin.y + radius, MAX_HEIGHT - 1); y++) {
+            memset(&flow_distance[y][left], 0, (size_t)(right - left + 1));
+        }
+    }
+
+    flow_origin = py.pos;
+    flow_opacity_changes = dg.floor.opacity_changes;
+
+    static Coord_t queue[MAX_HEIGHT * MAX_WIDTH];
+    int head = 0;
+    int tail = 0;
+
+    flow_distance[py.pos.y][py.pos.x] = 1;
+    queue[tail++] = py.pos;
+
+    while (head < tail) {
+        Coord_t coord = queue[head++];
+        uint8_t distance = flow_distance[coord.y][coord.x];
+
+        if (distance > radius) {
+            continue;
+        }
+
+        for (int y = coord.y - 1; y <= coord.y + 1; y++) {
+            for (int x = coord.x - 1; x <= coord.x + 1; x++) {
+                Coord_t spot = Coord_t{y, x};
+
+                if (coordInBounds(spot) && flow_distance[y][x] == 0 && monsterFlowPassable(spot)) {
+                    flow_distance[y][x] = (uint8_t)(distance + 1);
+                    queue[tail++] = spot;
+                }
+            }
+        }
+    }
+}
+
+// Reorder the move directions so that those leading down the flow map
+// towards the player are tried first, keeping the order of equal moves.
+// Monsters out of range of the flow map keep their directions.
+static void monsterFlowMoveDirections(int monster_id, int *directions) {
+    monsterUpdateFlowMap();
+
+    Coord_t const &pos = monsters[monster_id].pos;
+    if (flow_distance[pos.y][pos.x] == 0) {
+        return;
+    }
+
+    // The chosen directions first, then any others
+    int candidates[8];
+    int distances[8];
+    int count = 0;
+
+    for (int i = 0; i < 5; i++) {
+        candidates[count++] = directions[i];
+    }
+    for (int dir = 1; dir <= 9; dir++) {
+        bool chosen = dir == 5;
+        for (int i = 0; i < 5; i++) {
+            chosen |= directions[i] == dir;
+        }
+        if (!chosen) {
+            candidates[count++] = dir;
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        Coord_t coord = pos;
+        (void) playerMovePosition(candidates[i], coord);
+
+        distances[i] = flow_distance[coord.y][coord.x];
+        if (distances[i] == 0) {
+            distances[i] = UCHAR_MAX + 1;
+        }
+    }
+
+    // Insertion sort, as it is stable
+    for (int i = 1; i < count; i++) {
+        int candidate = candidates[i];
+        int distance = distances[i];
+
+        int j = i - 1;
+        for (; j >= 0 && distances[j] > distance; j--) {
+            candidates[j + 1] = candidates[j];
+            distances[j + 1] = distances[j];
+        }
+        candidates[j + 1] = candidate;
+        distances[j + 1] = distance;
+    }
+
+    for (int i = 0; i < 5; i++) {
+        directions[i] = candidates[i];
+    }
+}
+
+// `monster` is the message parameter for the attacker, see messageFormat().
+static void monsterPrintAttackDescription(int32_t monster, int attack_id) {
     switch (attack_id) {
         case 1:
-            printMessage(strcat(msg, "hits you."));
+            printMessageFormat(MessageSource::Combat, "%M hits you.", monster);
             break;
         case 2:
-            printMessage(strcat(msg, "bites you."));
+            printMessageFormat(MessageSource::Combat, "%M bites you.", monster);
             break;
         case 3:
-            printMessage(strcat(msg, "claws you."));
+            printMessageFormat(MessageSource::Combat, "%M claws you.", monster);
             break;
         case 4:
-            printMessage(strcat(msg, "stings you."));
+            printMessageFormat(MessageSource::Combat, "%M stings you.", monster);
             break;
         case 5:
-            printMessage(strcat(msg, "touches you."));
+            printMessageFormat(MessageSource::Combat, "%M touches you.", monster);
             break;
 #if 0
         case 6:
@@ -279,16 +411,16 @@ static void monsterPrintAttackDescription(char *msg, int attack_id) {
                     break;
 #endif
         case 7:
-            printMessage(strcat(msg, "gazes at you."));
+            printMessageFormat(MessageSource::Combat, "%M gazes at you.", monster);
             break;
         case 8:
-            printMessage(strcat(msg, "breathes on you."));
+            printMessageFormat(MessageSource::Combat, "%M breathes on you.", monster);
             break;
         case 9:
-            printMessage(strcat(msg, "spits on you."));
+            printMessageFormat(MessageSource::Combat, "%M spits on you.", monster);
             break;
         case 10:
-            printMessage(strcat(msg, "makes a horrible wail."));
+            printMessageFormat(MessageSource::Combat, "%M makes a horrible wail.", monster);
             break;
 #if 0
         case 11:
@@ -296,61 +428,61 @@ static void monsterPrintAttackDescription(char *msg, int attack_id) {
                     break;
 #endif
         case 12:
-            printMessage(strcat(msg, "crawls on you."));
+            printMessageFormat(MessageSource::Combat, "%M crawls on you.", monster);
             break;
         case 13:
-            printMessage(strcat(msg, "releases a cloud of spores."));
+            printMessageFormat(MessageSource::Combat, "%M releases a cloud of spores.", monster);
             break;
         case 14:
-            printMessage(strcat(msg, "begs you for money."));
+            printMessageFormat(MessageSource::Combat, "%M begs you for money.", monster);
             break;
         case 15:
             printMessage("You've been slimed!");
             break;
         case 16:
-            printMessage(strcat(msg, "crushes you."));
+            printMessageFormat(MessageSource::Combat, "%M crushes you.", monster);
             break;
         case 17:
-            printMessage(strcat(msg, "tramples you."));
+            printMessageFormat(MessageSource::Combat, "%M tramples you.", monster);
             break;
         case 18:
-            printMessage(strcat(msg, "drools on you."));
+            printMessageFormat(MessageSource::Combat, "%M drools on you.", monster);
             break;
         case 19:
             switch (randomNumber(9)) {
                 case 1:
-                    printMessage(strcat(msg, "insults you!"));
+                    printMessageFormat(MessageSource::Combat, "%M insults you!", monster);
                     break;
                 case 2:
-                    printMessage(strcat(msg, "insults your mother!"));
+                    printMessageFormat(MessageSource::Combat, "%M insults your mother!", monster);
                     break;
                 case 3:
-                    printMessage(strcat(msg, "gives you the finger!"));
+                    printMessageFormat(MessageSource::Combat, "%M gives you the finger!", monster);
                     break;
                 case 4:
-                    printMessage(strcat(msg, "humiliates you!"));
+                    printMessageFormat(MessageSource::Combat, "%M humiliates you!", monster);
                     break;
                 case 5:
-                    printMessage(strcat(msg, "wets on your leg!"));
+                    printMessageFormat(MessageSource::Combat, "%M wets on your leg!", monster);
                     break;
                 case 6:
-                    printMessage(strcat(msg, "defiles you!"));
+                    printMessageFormat(MessageSource::Combat, "%M defiles you!", monster);
                     break;
                 case 7:
-                    printMessage(strcat(msg, "dances around you!"));
+                    printMessageFormat(MessageSource::Combat, "%M dances around you!", monster);
                     break;
                 case 8:
-                    printMessage(strcat(msg, "makes obscene gestures!"));
+                    printMessageFormat(MessageSource::Combat, "%M makes obscene gestures!", monster);
                     break;
                 case 9:
-                    printMessage(strcat(msg, "moons you!!!"));
+                    printMessageFormat(MessageSource::Combat, "%M moons you!!!", monster);
                     break;
                 default:
                     break;
             }
             break;
         case 99:
-            printMessage(strcat(msg, "is repelled."));
+            printMessageFormat(MessageSource::Combat, "%M is repelled.", monster);
             break;
         default:
             break;
@@ -385,6 +517,8 @@ static void monsterConfuseOnAttack(Creature_t const &creature, Monster_t &monste
 
 // Make an attack on the player (chuckle.) -RAK-
 static void monsterAttackPlayer(int monster_id) {
+    RngStreamScope_t rng_scope(rng_streams.combat);
+
     // don't beat a dead body!
     if (game.character_is_dead) {
         return;
@@ -394,10 +528,12 @@ static void monsterAttackPlayer(int monster_id) {
     Creature_t const &creature = creatures_list[monster.creature_id];
 
     vtype_t name = {'\0'};
+    int32_t attacker = MESSAGE_UNSEEN_MONSTER;
     if (!monster.lit) {
         (void) strcpy(name, "It ");
     } else {
         (void) sprintf(name, "The %s ", creature.name);
+        attacker = monster.creature_id;
     }
 
     vtype_t death_description = {'\0'};
@@ -424,10 +560,7 @@ static void monsterAttackPlayer(int monster_id) {
         if (playerTestAttackHits(attack_type, creature.level)) {
             playerDisturb(1, 0);
 
-            // can not strcat to name because the creature may have multiple attacks.
-            vtype_t description = {'\0'};
-            (void) strcpy(description, name);
-            monsterPrintAttackDescription(description, attack_desc);
+            monsterPrintAttackDescription(attacker, attack_desc);
 
             // always fail to notice attack if creature invisible, set notice
             // and visible here since creature may be visible when attacking
@@ -463,9 +596,7 @@ static void monsterAttackPlayer(int monster_id) {
             if ((attack_desc >= 1 && attack_desc <= 3) || attack_desc == 6) {
                 playerDisturb(1, 0);
 
-                vtype_t description = {'\0'};
-                (void) strcpy(description, name);
-                printMessage(strcat(description, "misses you."));
+                printMessageFormat(MessageSource::Combat, "%M misses you.", attacker);
             }
         }
 
@@ -477,7 +608,7 @@ static void monsterAttackPlayer(int monster_id) {
     }
 }
 
-static void monsterOpenDoor(Tile_t &tile, int16_t monster_hp, uint32_t move_bits, bool &do_turn, bool &do_move, uint32_t &rcmove, Coord_t coord) {
+static void monsterOpenDoor(Tile_t tile, int16_t monster_hp, uint32_t move_bits, bool &do_turn, bool &do_move, uint32_t &rcmove, Coord_t coord) {
     Inventory_t &item = game.treasure.list[tile.treasure_id];
 
     // Creature can open doors.
@@ -560,7 +691,7 @@ static void glyphOfWardingProtection(uint16_t creature_id, uint32_t move_bits, b
     }
 }
 
-static void monsterMovesOnPlayer(Monster_t const &monster, uint8_t creature_id, int monster_id, uint32_t move_bits, bool &do_move, bool &do_turn, uint32_t &rcmove, Coord_t coord) {
+static void monsterMovesOnPlayer(Monster_t const &monster, uint16_t creature_id, int monster_id, uint32_t move_bits, bool &do_move, bool &do_turn, uint32_t &rcmove, Coord_t coord) {
     if (creature_id == 1) {
         // if the monster is not lit, must call monsterUpdateVisibility, it
         // may be faster than character, and hence could have
@@ -581,15 +712,9 @@ static void monsterMovesOnPlayer(Monster_t const &monster, uint8_t creature_id,
                 rcmove |= config::monsters::move::CM_EATS_OTHER;
             }
 
-            // It ate an already processed monster. Handle normally.
-            if (monster_id < creature_id) {
-                dungeonDeleteMonster((int) creature_id);
-            } else {
-                // If it eats this monster, an already processed
-                // monster will take its place, causing all kinds
-                // of havoc. Delay the kill a bit.
-                dungeonRemoveMonsterFromLevel((int) creature_id);
-            }
+            // Deleting a monster no longer moves any other monster
+            // to a new id, so it can go straight away.
+            dungeonDeleteMonster((int) creature_id);
         } else {
             do_move = false;
         }
@@ -639,7 +764,7 @@ static void makeMove(int monster_id, int *directions, uint32_t &rcmove) {
 
         (void) playerMovePosition(directions[i], coord);
 
-        Tile_t &tile = dg.floor[coord.y][coord.x];
+        Tile_t tile = dg.floor[coord.y][coord.x];
 
         if (tile.feature_id == TILE_BOUNDARY_WALL) {
             continue;
@@ -684,7 +809,7 @@ static bool monsterCanCastSpells(Monster_t const &monster, uint32_t spells) {
     bool within_range = monster.distance_from_player <= config::monsters::MON_MAX_SPELL_CAST_DISTANCE;
 
     // Must have unobstructed Line-Of-Sight
-    bool unobstructed = los(py.pos, monster.pos);
+    bool unobstructed = losFromPlayer(monster.pos);
 
     return within_range && unobstructed;
 }
@@ -1146,6 +1271,11 @@ static void monsterMoveNormally(int monster_id, uint32_t &rcmove) {
         directions[4] = randomNumber(9);
     } else {
         monsterGetMoveDirection(monster_id, directions);
+
+        // Walls don't stop phasing monsters, so they can head straight for the player
+        if ((creatures_list[monsters[monster_id].creature_id].movement & config::monsters::move::CM_PHASE) == 0u) {
+            monsterFlowMoveDirections(monster_id, directions);
+        }
     }
 
     rcmove |= config::monsters::move::CM_MOVE_NORMAL;
@@ -1314,8 +1444,20 @@ static void monsterAttackingUpdate(Monster_t &monster, int monster_id, int moves
 
 // Creatures movement and attacking are done from here -RAK-
 void updateMonsters(bool attack) {
-    // Process the monsters
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID && !game.character_is_dead; id--) {
+    TURN_STATS_PHASE(TurnPhase::Monsters);
+    RngStreamScope_t rng_scope(rng_streams.monsters);
+
+    monsterStartUpdatePass(attack);
+
+    // Process the monsters, only those the schedule says can do
+    // something this turn are looked at.
+    for (int id = monsterNextToUpdate(next_free_monster_id, attack); id != -1 && !game.character_is_dead; id = monsterNextToUpdate(id, attack)) {
+        if (monsterIsNewborn(id)) {
+            continue;
+        }
+
+        TURN_STATS_COUNT(TurnCounter::MonstersProcessed);
+
         Monster_t &monster = monsters[id];
 
         // Get rid of an eaten/breathed on monster.  Note: Be sure not to
@@ -1348,7 +1490,11 @@ void updateMonsters(bool attack) {
             dungeonDeleteMonsterRecord(id);
             continue;
         }
+
+        monsterScheduleUpdated(id, attack);
     }
+
+    monsterEndUpdatePass(attack);
 }
 
 // Decreases monsters hit points and deletes monster if needed.
@@ -1512,7 +1658,7 @@ bool monsterSleep(Coord_t coord) {
 
     for (int y = coord.y - 1; y <= coord.y + 1 && y < MAX_HEIGHT; y++) {
         for (int x = coord.x - 1; x <= coord.x + 1 && x < MAX_WIDTH; x++) {
-            uint8_t monster_id = dg.floor[y][x].creature_id;
+            uint16_t monster_id = dg.floor[y][x].creature_id;
 
             if (monster_id <= 1) {
                 continue;
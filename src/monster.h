@@ -56,10 +56,11 @@ constexpr uint16_t MON_MAX_CREATURES = 279; // Number of creatures defined for u
 constexpr uint8_t MON_ATTACK_TYPES = 215;   // Number of monster attack types.
 
 // With MON_TOTAL_ALLOCATIONS set to 101, it is possible to get compacting
-// monsters messages while breeding/cloning monsters.
-constexpr uint8_t MON_TOTAL_ALLOCATIONS = 125; // Max that can be allocated
-constexpr uint8_t MON_MAX_LEVELS = 40;         // Maximum level of creatures
-constexpr uint8_t MON_MAX_ATTACKS = 4;         // Max num attacks (used in mons memory) -CJS-
+// monsters messages while breeding/cloning monsters. Tiles hold 16-bit
+// creature ids, so this may go well beyond 255.
+constexpr uint16_t MON_TOTAL_ALLOCATIONS = 1024; // Max that can be allocated
+constexpr uint8_t MON_MAX_LEVELS = 40;            // Maximum level of creatures
+constexpr uint8_t MON_MAX_ATTACKS = 4;            // Max num attacks (used in mons memory) -CJS-
 
 extern int hack_monptr;
 extern Creature_t creatures_list[MON_MAX_CREATURES];
@@ -83,6 +84,27 @@ bool monsterSleep(Coord_t coord);
 bool compactMonsters();
 bool monsterPlaceNew(Coord_t coord, int creature_id, bool sleeping);
 void monsterPlaceWinning();
+bool monsterIsAllocated(int monster_id);
+bool monsterIsNewborn(int monster_id);
+void monsterStartUpdatePass(bool attack);
+void monsterEndUpdatePass(bool attack);
+int monsterNextToUpdate(int monster_id, bool attack);
+int monsterFreeSlotsTotal();
+void monsterResetSlots();
+void monsterClaimSlot(int monster_id);
+void monsterReleaseSlot(int monster_id);
+void monsterIndexInsert(int monster_id);
+void monsterIndexRemove(int monster_id);
+void monsterIndexMove(int monster_id, Coord_t const &to);
+void monsterIndexRebuild();
+int monsterIndexQuery(Coord_t const &top_left, Coord_t const &bottom_right, int16_t *ids);
+void monsterScheduleRebuild();
+void monsterScheduleAdd(int monster_id);
+void monsterScheduleWake(int monster_id);
+void monsterScheduleSpeedChanged(int monster_id);
+void monsterScheduleRefreshDistances();
+void monsterScheduleUpdated(int monster_id, bool attack);
+bool monsterAllDormant();
 void monsterPlaceNewWithinDistance(int number, int distance_from_source, bool sleeping);
 bool monsterSummon(Coord_t &coord, bool sleeping);
 bool monsterSummonUndead(Coord_t &coord);
@@ -9,6 +9,8 @@
 // Monster management: generation, placement, cleanup
 
 #include "headers.h"
+#include <algorithm>
+#include <functional>
 
 Monster_t monsters[MON_TOTAL_ALLOCATIONS];
 int16_t monster_levels[MON_MAX_LEVELS + 1];
@@ -16,18 +18,538 @@ int16_t monster_levels[MON_MAX_LEVELS + 1];
 // Values for a blank monster
 Monster_t blank_monster = {0, 0, 0, 0, Coord_t{0, 0}, 0, false, 0, 0};
 
-int16_t next_free_monster_id;   // ID for the next available monster ptr
+int16_t next_free_monster_id;   // One past the highest monster slot in use
 int16_t monster_multiply_total; // Total number of reproduction's of creatures
 
+// Monster slots are handed out lowest free slot first, from a bitmap of the
+// slots in use. Deleting a monster simply marks its slot free again, so
+// monster ids stay put for as long as the monster lives, and the scans
+// over monsters[] only need to run up to `next_free_monster_id`.
+constexpr int MON_SLOT_WORDS = (MON_TOTAL_ALLOCATIONS + 63) / 64;
+
+static uint64_t monster_slots_used[MON_SLOT_WORDS];
+static uint64_t monster_slots_newborn[MON_SLOT_WORDS];
+static uint64_t monster_slots_monsters[MON_SLOT_WORDS]; // every slot but those below MON_MIN_INDEX_ID
+static int monster_slots_used_total = 0;
+
+static void monsterScheduleReset();
+static void monsterScheduleRemove(int monster_id);
+
+bool monsterIsAllocated(int monster_id) {
+    return (monster_slots_used[monster_id / 64] & (1ULL << (monster_id % 64))) != 0;
+}
+
+// Newborn monsters were placed during the current updateMonsters() pass,
+// possibly into a free slot the pass has still to reach, and so must wait
+// for the next pass before they get to act.
+bool monsterIsNewborn(int monster_id) {
+    return (monster_slots_newborn[monster_id / 64] & (1ULL << (monster_id % 64))) != 0;
+}
+
+int monsterFreeSlotsTotal() {
+    return MON_TOTAL_ALLOCATIONS - config::monsters::MON_MIN_INDEX_ID - monster_slots_used_total;
+}
+
+// Marks every monster slot as free, the ids below MON_MIN_INDEX_ID are
+// never handed out.
+void monsterResetSlots() {
+    for (int i = 0; i < MON_SLOT_WORDS; i++) {
+        monster_slots_used[i] = 0;
+        monster_slots_newborn[i] = 0;
+        monster_slots_monsters[i] = ~0ULL;
+    }
+    for (int id = 0; id < config::monsters::MON_MIN_INDEX_ID; id++) {
+        monster_slots_used[id / 64] |= 1ULL << (id % 64);
+        monster_slots_monsters[id / 64] &= ~(1ULL << (id % 64));
+    }
+
+    monster_slots_used_total = 0;
+    next_free_monster_id = config::monsters::MON_MIN_INDEX_ID;
+
+    monsterScheduleReset();
+}
+
+void monsterClaimSlot(int monster_id) {
+    monster_slots_used[monster_id / 64] |= 1ULL << (monster_id % 64);
+    monster_slots_used_total++;
+
+    if (monster_id >= next_free_monster_id) {
+        next_free_monster_id = (int16_t)(monster_id + 1);
+    }
+}
+
+void monsterReleaseSlot(int monster_id) {
+    monster_slots_used[monster_id / 64] &= ~(1ULL << (monster_id % 64));
+    monster_slots_newborn[monster_id / 64] &= ~(1ULL << (monster_id % 64));
+    monster_slots_used_total--;
+
+    monsterScheduleRemove(monster_id);
+
+    while (next_free_monster_id > config::monsters::MON_MIN_INDEX_ID && !monsterIsAllocated(next_free_monster_id - 1)) {
+        next_free_monster_id--;
+    }
+}
+
+static int monsterLowestFreeSlot() {
+    for (int word = 0; word < MON_SLOT_WORDS; word++) {
+        uint64_t free_slots = ~monster_slots_used[word];
+        if (free_slots == 0) {
+            continue;
+        }
+
+        int bit = 0;
+        while ((free_slots & (1ULL << bit)) == 0) {
+            bit++;
+        }
+
+        int monster_id = word * 64 + bit;
+        return monster_id < MON_TOTAL_ALLOCATIONS ? monster_id : -1;
+    }
+
+    return -1;
+}
+
+// Monster spatial index -- every allocated monster is filed under the
+// half-screen block (as used by rooms and panels) it is standing in, so
+// area queries only need to walk the blocks that overlap the area rather
+// than the whole of monsters[]. Each block is a doubly linked list of ids.
+constexpr int MON_INDEX_BLOCK_HEIGHT = SCREEN_HEIGHT / 2;
+constexpr int MON_INDEX_BLOCK_WIDTH = SCREEN_WIDTH / 2;
+constexpr int MON_INDEX_BLOCK_ROWS = (MAX_HEIGHT + MON_INDEX_BLOCK_HEIGHT - 1) / MON_INDEX_BLOCK_HEIGHT;
+constexpr int MON_INDEX_BLOCK_COLUMNS = (MAX_WIDTH + MON_INDEX_BLOCK_WIDTH - 1) / MON_INDEX_BLOCK_WIDTH;
+
+static int16_t monster_index_heads[MON_INDEX_BLOCK_ROWS * MON_INDEX_BLOCK_COLUMNS];
+static int16_t monster_index_next[MON_TOTAL_ALLOCATIONS];
+static int16_t monster_index_prev[MON_TOTAL_ALLOCATIONS];
+static int16_t monster_index_block[MON_TOTAL_ALLOCATIONS];
+
+static int monsterIndexBlockFor(Coord_t const &coord) {
+    return (coord.y / MON_INDEX_BLOCK_HEIGHT) * MON_INDEX_BLOCK_COLUMNS + coord.x / MON_INDEX_BLOCK_WIDTH;
+}
+
+static void monsterIndexLink(int monster_id, int block) {
+    monster_index_block[monster_id] = (int16_t) block;
+    monster_index_prev[monster_id] = -1;
+    monster_index_next[monster_id] = monster_index_heads[block];
+
+    if (monster_index_heads[block] != -1) {
+        monster_index_prev[monster_index_heads[block]] = (int16_t) monster_id;
+    }
+    monster_index_heads[block] = (int16_t) monster_id;
+}
+
+// Adds a monster to the index, using its current position.
+void monsterIndexInsert(int monster_id) {
+    monsterIndexLink(monster_id, monsterIndexBlockFor(monsters[monster_id].pos));
+}
+
+// Removes a monster from the index, safe to call when it was never added.
+void monsterIndexRemove(int monster_id) {
+    int block = monster_index_block[monster_id];
+    if (block == -1) {
+        return;
+    }
+
+    int prev = monster_index_prev[monster_id];
+    int next = monster_index_next[monster_id];
+
+    if (prev == -1) {
+        monster_index_heads[block] = (int16_t) next;
+    } else {
+        monster_index_next[prev] = (int16_t) next;
+    }
+    if (next != -1) {
+        monster_index_prev[next] = (int16_t) prev;
+    }
+
+    monster_index_block[monster_id] = -1;
+}
+
+// Refiles a monster that is about to be moved to a new location.
+void monsterIndexMove(int monster_id, Coord_t const &to) {
+    int block = monsterIndexBlockFor(to);
+    if (block == monster_index_block[monster_id]) {
+        return;
+    }
+
+    monsterIndexRemove(monster_id);
+    monsterIndexLink(monster_id, block);
+}
+
+// Throws away the index and refiles every allocated monster, used
+// whenever monsters[] is replaced wholesale (new level, restored game).
+void monsterIndexRebuild() {
+    for (auto &head : monster_index_heads) {
+        head = -1;
+    }
+    for (auto &block : monster_index_block) {
+        block = -1;
+    }
+
+    for (int id = config::monsters::MON_MIN_INDEX_ID; id < next_free_monster_id; id++) {
+        if (monsterIsAllocated(id)) {
+            monsterIndexInsert(id);
+        }
+    }
+}
+
+// Collects the ids of all monsters inside the given rectangle (inclusive)
+// into `ids`, which must hold MON_TOTAL_ALLOCATIONS entries. The ids are
+// returned highest first, matching the order of the usual scan from
+// `next_free_monster_id - 1` downwards, so callers may delete the current
+// monster as they go. Returns the number of ids found.
+int monsterIndexQuery(Coord_t const &top_left, Coord_t const &bottom_right, int16_t *ids) {
+    int top = std::max(0, top_left.y) / MON_INDEX_BLOCK_HEIGHT;
+    int left = std::max(0, top_left.x) / MON_INDEX_BLOCK_WIDTH;
+    int bottom = std::min(MAX_HEIGHT - 1, bottom_right.y) / MON_INDEX_BLOCK_HEIGHT;
+    int right = std::min(MAX_WIDTH - 1, bottom_right.x) / MON_INDEX_BLOCK_WIDTH;
+
+    int count = 0;
+
+    for (int row = top; row <= bottom; row++) {
+        for (int column = left; column <= right; column++) {
+            for (int id = monster_index_heads[row * MON_INDEX_BLOCK_COLUMNS + column]; id != -1; id = monster_index_next[id]) {
+                Coord_t const &pos = monsters[id].pos;
+
+                if (pos.y < top_left.y || pos.y > bottom_right.y || pos.x < top_left.x || pos.x > bottom_right.x) {
+                    continue;
+                }
+
+                ids[count++] = (int16_t) id;
+            }
+        }
+    }
+
+    std::sort(ids, ids + count, std::greater<int16_t>());
+
+    return count;
+}
+
+// Monster schedule -- which monsters an updateMonsters() pass has to look
+// at. Looking at every monster on every turn is wasted on most of them: a
+// slow monster only gets a move on the turns monsterMovementRate() gives it,
+// and a monster that is unlit, out of sight and too far away to notice the
+// player does nothing at all with its moves. Every monster is filed under
+// one of:
+//
+//   dormant    -- such a monster, whether asleep or awake, it is left alone
+//                 until the player comes within sight of it or makes a
+//                 noise, or something else happens to it.
+//   every turn -- a speed above zero, it moves on every turn.
+//   the wheel  -- a speed of zero or below, filed under the turn of its next
+//                 move, modulo MON_SCHEDULE_TURNS.
+//
+// A monster is also watched, and looked at on every pass, for as long as
+// it is lit, within MON_MAX_SIGHT of the player, or dead and waiting for
+// its record to be deleted. Whether a monster moves, and how often, is
+// still decided by monsterMovementRate(), so monsters act on exactly the
+// turns they always did, the pass only skips the visits that do nothing.
+constexpr int MON_SCHEDULE_TURNS = 64;
+
+static uint64_t monster_schedule_wheel[MON_SCHEDULE_TURNS][MON_SLOT_WORDS];
+static uint64_t monster_schedule_every_turn[MON_SLOT_WORDS];
+static uint64_t monster_schedule_dormant[MON_SLOT_WORDS];
+static uint64_t monster_schedule_watched[MON_SLOT_WORDS];
+static int8_t monster_schedule_wheel_slot[MON_TOTAL_ALLOCATIONS]; // -1 when not on the wheel
+
+// The turn of the last pass handing out moves, and the id it has got down
+// to. The ids above it have had their chance to move on that turn, once
+// the pass is over that is all of them.
+static int32_t monster_pass_turn = -1;
+static int monster_pass_id = -1;
+
+// Where the passes last saw the player. The monsters the passes skip keep
+// the distance they were last given, the distance they would have been
+// given is worked out from here when needed.
+static Coord_t monster_pass_player_pos = Coord_t{-1, -1};
+
+static void monsterScheduleSet(uint64_t *bits, int monster_id) {
+    bits[monster_id / 64] |= 1ULL << (monster_id % 64);
+}
+
+static void monsterScheduleClear(uint64_t *bits, int monster_id) {
+    bits[monster_id / 64] &= ~(1ULL << (monster_id % 64));
+}
+
+static bool monsterScheduleTest(uint64_t const *bits, int monster_id) {
+    return (bits[monster_id / 64] & (1ULL << (monster_id % 64))) != 0;
+}
+
+static void monsterScheduleUnfile(int monster_id) {
+    monsterScheduleClear(monster_schedule_every_turn, monster_id);
+    monsterScheduleClear(monster_schedule_dormant, monster_id);
+
+    if (monster_schedule_wheel_slot[monster_id] != -1) {
+        monsterScheduleClear(monster_schedule_wheel[monster_schedule_wheel_slot[monster_id]], monster_id);
+        monster_schedule_wheel_slot[monster_id] = -1;
+    }
+}
+
+// Files a monster under its next move, on `turn` or later.
+static void monsterScheduleFile(int monster_id, int32_t turn) {
+    int16_t speed = monsters[monster_id].speed;
+    if (speed > 0) {
+        if (!monsterScheduleTest(monster_schedule_every_turn, monster_id)) {
+            monsterScheduleUnfile(monster_id);
+            monsterScheduleSet(monster_schedule_every_turn, monster_id);
+        }
+        return;
+    }
+
+    // a slow monster moves on the turns which are a multiple of this
+    int32_t period = 2 - speed;
+    int32_t next_move = turn <= 0 ? 0 : ((turn + period - 1) / period) * period;
+
+    auto slot = (int8_t)(next_move % MON_SCHEDULE_TURNS);
+    if (slot != monster_schedule_wheel_slot[monster_id]) {
+        monsterScheduleUnfile(monster_id);
+        monsterScheduleSet(monster_schedule_wheel[slot], monster_id);
+        monster_schedule_wheel_slot[monster_id] = slot;
+    }
+}
+
+// A monster filed during a turn may still move on it, unless the
+// pass for this turn has already gone by it.
+static int32_t monsterScheduleFirstTurn(int monster_id) {
+    if (monster_pass_turn == dg.game_turn && (monster_id > monster_pass_id || monsterIsNewborn(monster_id))) {
+        return dg.game_turn + 1;
+    }
+    return dg.game_turn;
+}
+
+static bool monsterScheduleMustWatch(Monster_t const &monster) {
+    return monster.lit || monster.distance_from_player <= config::monsters::MON_MAX_SIGHT || monster.hp < 0;
+}
+
+// Creatures which notice the player from further away than MON_MAX_SIGHT
+// are never dormant, so looking around the player out to MON_MAX_SIGHT is
+// enough to find every dormant monster that has to be woken.
+static bool monsterScheduleIsDormant(Monster_t const &monster) {
+    if (monsterScheduleMustWatch(monster)) {
+        return false;
+    }
+
+    Creature_t const &creature = creatures_list[monster.creature_id];
+
+    // monsters trapped in rock must be given their moves
+    bool in_rock = (creature.movement & config::monsters::move::CM_PHASE) == 0u && dg.floor[monster.pos.y][monster.pos.x].feature_id >= MIN_CAVE_WALL;
+
+    return creature.area_affect_radius <= config::monsters::MON_MAX_SIGHT && !in_rock;
+}
+
+static void monsterScheduleReset() {
+    for (auto &slot : monster_schedule_wheel) {
+        for (auto &word : slot) {
+            word = 0;
+        }
+    }
+    for (int i = 0; i < MON_SLOT_WORDS; i++) {
+        monster_schedule_every_turn[i] = 0;
+        monster_schedule_dormant[i] = 0;
+        monster_schedule_watched[i] = 0;
+    }
+    for (auto &slot : monster_schedule_wheel_slot) {
+        slot = -1;
+    }
+}
+
+// Files a newly placed monster, it is looked at on the next pass unless
+// it starts out dormant. Its distance may have been worked out from where
+// the player was before being placed on a new level, so the player's
+// current position is checked too.
+void monsterScheduleAdd(int monster_id) {
+    Monster_t const &monster = monsters[monster_id];
+
+    if (monsterScheduleIsDormant(monster) && coordDistanceBetween(py.pos, monster.pos) > config::monsters::MON_MAX_SIGHT) {
+        monsterScheduleUnfile(monster_id);
+        monsterScheduleSet(monster_schedule_dormant, monster_id);
+        return;
+    }
+
+    monsterScheduleFile(monster_id, monsterScheduleFirstTurn(monster_id));
+    monsterScheduleSet(monster_schedule_watched, monster_id);
+}
+
+static void monsterScheduleRemove(int monster_id) {
+    monsterScheduleUnfile(monster_id);
+    monsterScheduleClear(monster_schedule_watched, monster_id);
+}
+
+// Files every allocated monster afresh, used whenever monsters[] is
+// replaced wholesale (new level, restored game).
+void monsterScheduleRebuild() {
+    monsterScheduleReset();
+    monster_pass_player_pos = py.pos;
+
+    for (int id = config::monsters::MON_MIN_INDEX_ID; id < next_free_monster_id; id++) {
+        if (monsterIsAllocated(id)) {
+            monsterScheduleAdd(id);
+        }
+    }
+}
+
+// Makes sure the next pass looks at a monster, taking it out of the
+// dormant set. For when something other than its own moves happened to
+// it: it was moved, lit up, woken up or killed, or the player made a noise.
+void monsterScheduleWake(int monster_id) {
+    Monster_t &monster = monsters[monster_id];
+
+    if (!monsterScheduleTest(monster_schedule_watched, monster_id)) {
+        monster.distance_from_player = (uint8_t) coordDistanceBetween(monster_pass_player_pos, monster.pos);
+        monsterScheduleSet(monster_schedule_watched, monster_id);
+    }
+
+    if (monsterScheduleTest(monster_schedule_dormant, monster_id)) {
+        monsterScheduleFile(monster_id, monsterScheduleFirstTurn(monster_id));
+    }
+}
+
+// Files a monster again after its speed was changed, a dormant
+// monster is filed when it is woken.
+void monsterScheduleSpeedChanged(int monster_id) {
+    if (!monsterScheduleTest(monster_schedule_dormant, monster_id)) {
+        monsterScheduleFile(monster_id, monsterScheduleFirstTurn(monster_id));
+    }
+}
+
+// Brings the distances of the monsters the passes have been skipping up
+// to date, for the code which looks at the distance of every monster.
+void monsterScheduleRefreshDistances() {
+    for (int id = config::monsters::MON_MIN_INDEX_ID; id < next_free_monster_id; id++) {
+        if (monsterIsAllocated(id) && !monsterScheduleTest(monster_schedule_watched, id)) {
+            monsters[id].distance_from_player = (uint8_t) coordDistanceBetween(monster_pass_player_pos, monsters[id].pos);
+        }
+    }
+}
+
+// Watches the monsters that have come within sight since the passes last
+// saw the player, which may be in the middle of a pass if a monster
+// teleported the player.
+static void monsterScheduleLookAround() {
+    if (py.pos.y == monster_pass_player_pos.y && py.pos.x == monster_pass_player_pos.x) {
+        return;
+    }
+
+    int16_t ids[MON_TOTAL_ALLOCATIONS];
+    int sight = config::monsters::MON_MAX_SIGHT;
+    int count = monsterIndexQuery(Coord_t{py.pos.y - sight, py.pos.x - sight}, Coord_t{py.pos.y + sight, py.pos.x + sight}, ids);
+
+    for (int i = 0; i < count; i++) {
+        if (coordDistanceBetween(py.pos, monsters[ids[i]].pos) <= sight) {
+            monsterScheduleWake(ids[i]);
+        }
+    }
+
+    monster_pass_player_pos = py.pos;
+}
+
+void monsterStartUpdatePass(bool attack) {
+    for (auto &word : monster_slots_newborn) {
+        word = 0;
+    }
+
+    if (attack) {
+        monster_pass_turn = dg.game_turn;
+        monster_pass_id = MON_TOTAL_ALLOCATIONS;
+    }
+
+    monsterScheduleLookAround();
+}
+
+void monsterEndUpdatePass(bool attack) {
+    if (attack) {
+        monster_pass_id = -1;
+    }
+}
+
+// Returns the highest id below `monster_id` that the pass has to look at,
+// or -1 when there are none left. Only a pass handing out moves looks at
+// the monsters due to move.
+int monsterNextToUpdate(int monster_id, bool attack) {
+    monsterScheduleLookAround();
+
+    int slot = ((dg.game_turn % MON_SCHEDULE_TURNS) + MON_SCHEDULE_TURNS) % MON_SCHEDULE_TURNS;
+
+    for (int id = monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id = (id / 64) * 64 - 1) {
+        int word = id / 64;
+
+        uint64_t candidates = monster_schedule_watched[word];
+        if (attack) {
+            candidates |= monster_schedule_every_turn[word] | monster_schedule_wheel[slot][word];
+        }
+        if (id % 64 != 63) {
+            candidates &= (1ULL << (id % 64 + 1)) - 1;
+        }
+        if (candidates == 0) {
+            continue;
+        }
+
+        int bit = id % 64;
+        while ((candidates & (1ULL << bit)) == 0) {
+            bit--;
+        }
+
+        int found = word * 64 + bit;
+        if (found < config::monsters::MON_MIN_INDEX_ID) {
+            return -1;
+        }
+
+        if (attack) {
+            monster_pass_id = found;
+        }
+        return found;
+    }
+
+    return -1;
+}
+
+// True when every monster is dormant, so a pass handing out moves
+// would find none that could do anything.
+bool monsterAllDormant() {
+    uint64_t active = 0;
+
+    for (int word = 0; word < MON_SLOT_WORDS; word++) {
+        active |= monster_slots_used[word] & ~monster_schedule_dormant[word] & monster_slots_monsters[word];
+    }
+
+    return active == 0;
+}
+
+// Files a monster again once the pass has looked at it. A pass handing
+// out moves has used up its move for this turn.
+void monsterScheduleUpdated(int monster_id, bool attack) {
+    Monster_t const &monster = monsters[monster_id];
+
+    if (monsterScheduleMustWatch(monster)) {
+        monsterScheduleSet(monster_schedule_watched, monster_id);
+    } else {
+        monsterScheduleClear(monster_schedule_watched, monster_id);
+    }
+
+    if (monsterScheduleIsDormant(monster)) {
+        monsterScheduleUnfile(monster_id);
+        monsterScheduleSet(monster_schedule_dormant, monster_id);
+    } else if (attack) {
+        monsterScheduleFile(monster_id, dg.game_turn + 1);
+    }
+}
+
 // Returns a pointer to next free space -RAK-
 // Returns -1 if could not allocate a monster.
 static int popm() {
-    if (next_free_monster_id == MON_TOTAL_ALLOCATIONS) {
+    int monster_id = monsterLowestFreeSlot();
+
+    if (monster_id == -1) {
         if (!compactMonsters()) {
             return -1;
         }
+        monster_id = monsterLowestFreeSlot();
     }
-    return next_free_monster_id++;
+
+    monsterClaimSlot(monster_id);
+    monster_slots_newborn[monster_id / 64] |= 1ULL << (monster_id % 64);
+
+    return monster_id;
 }
 
 // Places a monster at given location -RAK-
@@ -57,7 +579,9 @@ bool monsterPlaceNew(Coord_t coord, int creature_id, bool sleeping) {
     monster.distance_from_player = (uint8_t) coordDistanceBetween(py.pos, coord);
     monster.lit = false;
 
-    dg.floor[coord.y][coord.x].creature_id = (uint8_t) monster_id;
+    dg.floor[coord.y][coord.x].creature_id = (uint16_t) monster_id;
+    monsterIndexInsert(monster_id);
+    monsterScheduleAdd(monster_id);
 
     if (sleeping) {
         if (creatures_list[creature_id].sleep_counter == 0) {
@@ -121,7 +645,9 @@ void monsterPlaceWinning() {
     monster.stunned_amount = 0;
     monster.distance_from_player = (uint8_t) coordDistanceBetween(py.pos, coord);
 
-    dg.floor[coord.y][coord.x].creature_id = (uint8_t) monster_id;
+    dg.floor[coord.y][coord.x].creature_id = (uint16_t) monster_id;
+    monsterIndexInsert(monster_id);
+    monsterScheduleAdd(monster_id);
 
     monster.sleep_count = 0;
 }
@@ -251,13 +777,21 @@ bool monsterSummonUndead(Coord_t &coord) {
 // Compact monsters -RAK-
 // Return true if any monsters were deleted, false if could not delete any monsters.
 bool compactMonsters() {
+    TURN_STATS_PHASE(TurnPhase::Compact);
+
     printMessage("Compacting monsters...");
 
+    monsterScheduleRefreshDistances();
+
     int cur_dis = 66;
     bool delete_any = false;
 
     while (!delete_any) {
         for (int i = next_free_monster_id - 1; i >= config::monsters::MON_MIN_INDEX_ID; i--) {
+            if (!monsterIsAllocated(i)) {
+                continue;
+            }
+
             if (cur_dis < monsters[i].distance_from_player && randomNumber(3) == 1) {
                 if ((creatures_list[monsters[i].creature_id].movement & config::monsters::move::CM_WIN) != 0u) {
                     // Never compact away the Balrog!!
@@ -267,7 +801,7 @@ bool compactMonsters() {
                     dungeonDeleteMonster(i);
                     delete_any = true;
                 } else {
-                    // dungeonRemoveMonsterFromLevel() does not decrement next_free_monster_id,
+                    // dungeonRemoveMonsterFromLevel() does not free the monster slot,
                     // so don't set delete_any if this was called.
                     dungeonRemoveMonsterFromLevel(i);
                 }
@@ -375,7 +375,10 @@ void playerChangeSpeed(int speed) {
     py.flags.status |= config::player::status::PY_SPEED;
 
     for (int i = next_free_monster_id - 1; i >= config::monsters::MON_MIN_INDEX_ID; i--) {
-        monsters[i].speed += speed;
+        if (monsterIsAllocated(i)) {
+            monsters[i].speed += speed;
+            monsterScheduleSpeedChanged(i);
+        }
     }
 }
 
@@ -1108,6 +1111,8 @@ static int playerCalculateBaseToHit(bool creature_lit, int tot_tohit) {
 
 // Player attacks a (poor, defenseless) creature -RAK-
 static void playerAttackMonster(Coord_t coord) {
+    RngStreamScope_t rng_scope(rng_streams.combat);
+
     int creature_id = dg.floor[coord.y][coord.x].creature_id;
 
     Monster_t &monster = monsters[creature_id];
@@ -1118,10 +1123,12 @@ static void playerAttackMonster(Coord_t coord) {
 
     // Does the player know what they're fighting?
     vtype_t name = {'\0'};
+    int32_t target = MESSAGE_UNSEEN_MONSTER;
     if (!monster.lit) {
         (void) strcpy(name, "it");
     } else {
         (void) sprintf(name, "the %s", creature.name);
+        target = monster.creature_id;
     }
 
     int blows, total_to_hit;
@@ -1136,13 +1143,11 @@ static void playerAttackMonster(Coord_t coord) {
     // Note: blows will always be greater than 0 at the start of the loop -MRC-
     for (int i = blows; i > 0; i--) {
         if (!playerTestBeingHit(base_to_hit, (int) py.misc.level, total_to_hit, (int) creature.ac, PlayerClassLevelAdj::BTH)) {
-            (void) sprintf(msg, "You miss %s.", name);
-            printMessage(msg);
+            printMessageFormat(MessageSource::Combat, "You miss %m.", target);
             continue;
         }
 
-        (void) sprintf(msg, "You hit %s.", name);
-        printMessage(msg);
+        printMessageFormat(MessageSource::Combat, "You hit %m.", target);
 
         if (item.category_id != TV_NOTHING) {
             damage = diceRoll(item.damage);
@@ -1183,8 +1188,7 @@ static void playerAttackMonster(Coord_t coord) {
 
         // See if we done it in.
         if (monsterTakeHit(creature_id, damage) >= 0) {
-            (void) sprintf(msg, "You have slain %s.", name);
-            printMessage(msg);
+            printMessageFormat(MessageSource::Combat, "You have slain %m.", target);
             displayCharacterExperience();
 
             return;
@@ -1218,7 +1222,7 @@ static int16_t playerLockPickingSkill() {
 }
 
 static void openClosedDoor(Coord_t coord) {
-    Tile_t &tile = dg.floor[coord.y][coord.x];
+    Tile_t tile = dg.floor[coord.y][coord.x];
     Inventory_t &item = game.treasure.list[tile.treasure_id];
 
     if (item.misc_use > 0) {
@@ -1344,7 +1348,7 @@ void playerCloseDoor() {
     Coord_t coord = py.pos;
     (void) playerMovePosition(dir, coord);
 
-    Tile_t &tile = dg.floor[coord.y][coord.x];
+    Tile_t tile = dg.floor[coord.y][coord.x];
     Inventory_t &item = game.treasure.list[tile.treasure_id];
 
     bool no_object = false;
@@ -1382,7 +1386,7 @@ bool playerTunnelWall(Coord_t coord, int digging_ability, int digging_chance) {
         return false;
     }
 
-    Tile_t &tile = dg.floor[coord.y][coord.x];
+    Tile_t tile = dg.floor[coord.y][coord.x];
 
     if (tile.perma_lit_room) {
         // Should become a room space, check to see whether
@@ -13,7 +13,7 @@
 
 static void playerBashAttack(Coord_t coord);
 static void playerBashPosition(Coord_t coord);
-static void playerBashClosedDoor(Coord_t coord, int dir, Tile_t &tile, Inventory_t &item);
+static void playerBashClosedDoor(Coord_t coord, int dir, Tile_t tile, Inventory_t &item);
 static void playerBashClosedChest(Inventory_t &item);
 
 // Bash open a door or chest -RAK-
@@ -49,7 +49,7 @@ void playerBash() {
     Coord_t coord = py.pos;
     (void) playerMovePosition(dir, coord);
 
-    Tile_t &tile = dg.floor[coord.y][coord.x];
+    Tile_t tile = dg.floor[coord.y][coord.x];
 
     if (tile.creature_id > 1) {
         playerBashPosition(coord);
@@ -92,10 +92,12 @@ static void playerBashAttack(Coord_t coord) {
 
     // Does the player know what they're fighting?
     vtype_t name = {'\0'};
+    int32_t target = MESSAGE_UNSEEN_MONSTER;
     if (!monster.lit) {
         (void) strcpy(name, "it");
     } else {
         (void) sprintf(name, "the %s", creature.name);
+        target = monster.creature_id;
     }
 
     int base_to_hit = py.stats.used[PlayerAttr::A_STR];
@@ -109,9 +111,7 @@ static void playerBashAttack(Coord_t coord) {
     }
 
     if (playerTestBeingHit(base_to_hit, (int) py.misc.level, (int) py.stats.used[PlayerAttr::A_DEX], (int) creature.ac, PlayerClassLevelAdj::BTH)) {
-        vtype_t msg = {'\0'};
-        (void) sprintf(msg, "You hit %s.", name);
-        printMessage(msg);
+        printMessageFormat(MessageSource::Combat, "You hit %m.", target);
 
         int damage = diceRoll(py.inventory[PlayerEquipment::Arm].damage);
         damage = playerWeaponCriticalBlow(py.inventory[PlayerEquipment::Arm].weight / 4 + py.stats.used[PlayerAttr::A_STR], 0, damage, PlayerClassLevelAdj::BTH);
@@ -124,10 +124,10 @@ static void playerBashAttack(Coord_t coord) {
 
         // See if we done it in.
         if (monsterTakeHit(monster_id, damage) >= 0) {
-            (void) sprintf(msg, "You have slain %s.", name);
-            printMessage(msg);
+            printMessageFormat(MessageSource::Combat, "You have slain %m.", target);
             displayCharacterExperience();
         } else {
+            vtype_t msg = {'\0'};
             name[0] = (char) toupper((int) name[0]); // Capitalize
 
             // Can not stun Balrog
@@ -152,9 +152,7 @@ static void playerBashAttack(Coord_t coord) {
             printMessage(msg);
         }
     } else {
-        vtype_t msg = {'\0'};
-        (void) sprintf(msg, "You miss %s.", name);
-        printMessage(msg);
+        printMessageFormat(MessageSource::Combat, "You miss %m.", target);
     }
 
     if (randomNumber(150) > py.stats.used[PlayerAttr::A_DEX]) {
@@ -173,7 +171,7 @@ static void playerBashPosition(Coord_t coord) {
     playerBashAttack(coord);
 }
 
-static void playerBashClosedDoor(Coord_t coord, int dir, Tile_t &tile, Inventory_t &item) {
+static void playerBashClosedDoor(Coord_t coord, int dir, Tile_t tile, Inventory_t &item) {
     printMessageNoCommandInterrupt("You smash into the door!");
 
     int chance = py.stats.used[PlayerAttr::A_STR] + py.misc.weight / 2;
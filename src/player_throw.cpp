@@ -265,7 +265,7 @@ void playerThrowItem() {
 
                 if (coordInsidePanel(coord) && py.flags.blind < 1 && (tile.temporary_light || tile.permanent_light)) {
                     panelPutTile(tile_char, coord);
-                    putQIO(); // show object moving
+                    panelShowFrame(); // show object moving
                 }
             }
         } else {
@@ -0,0 +1,260 @@
+// Copyright (c) 1981-86 Robert A. Koeneke
+// Copyright (c) 1987-94 James E. Wilson
+//
+// This work is free software released under the GNU General Public License
+// version 2.0, and comes with ABSOLUTELY NO WARRANTY.
+//
+// See LICENSE and AUTHORS for more information.
+
+// Recording and playing back replays of whole games
+
+#include "headers.h"
+#include <vector>
+
+// A replay holds everything needed to play a game again exactly as it was
+// played: the seed the game was started with, and every key press the game
+// read. It starts with a short text header:
+//
+//   UMORIA REPLAY 1
+//   seed 1234567
+//   wizard 0
+//   script 0
+//
+// `script` is 1 when the keys were read from a batch command script, which
+// never answers a -more- prompt, so none are recorded for them, and the
+// prompts have to be skipped again when the replay is played back.
+//
+// The header is followed by the key presses, one byte each. Byte
+// REPLAY_ESCAPE starts a two byte code: REPLAY_ESCAPE twice is a key press
+// of that value, and REPLAY_ESCAPE 'P' is followed by the 32 bit number
+// (low byte first) of a checkForNonBlockingKeyPress() poll which found a
+// key had been pressed, interrupting a rest or run. The key itself is not
+// recorded, as the game throws it away.
+//
+// A replay is always of a new character, as the saved game it would need
+// to start from may since have changed.
+constexpr char REPLAY_SIGNATURE[] = "UMORIA REPLAY 1";
+constexpr uint8_t REPLAY_ESCAPE = 0xFF;
+constexpr uint8_t REPLAY_KEY_PRESS_WAITING = 'P';
+
+static FILE *recording = nullptr;
+static std::string recording_filename;
+static uint32_t recording_polls = 0;
+
+static std::vector<uint8_t> playback;
+static size_t playback_pos = 0;
+static bool playback_on = false;
+static int32_t playback_stop_turn = -1;
+static uint32_t playback_polls = 0;
+
+static int replayReadKey();
+static bool replayKeyPressWaiting();
+
+static const KeySource_t replay_key_source = {replayReadKey, replayKeyPressWaiting, false};
+static const KeySource_t replay_script_key_source = {replayReadKey, replayKeyPressWaiting, true};
+
+// Start recording a new game started with `seed`, to the file `filename`.
+// Set `script` when the keys are to be read from a batch command script.
+bool replayStartRecording(const std::string &filename, uint32_t seed, bool wizard, bool script) {
+    recording = fopen(filename.c_str(), "wb");
+    if (recording == nullptr) {
+        return false;
+    }
+
+    recording_filename = filename;
+    recording_polls = 0;
+
+    (void) fprintf(recording, "%s\nseed %u\nwizard %d\nscript %d\n", REPLAY_SIGNATURE, seed, wizard ? 1 : 0, script ? 1 : 0);
+    (void) fflush(recording);
+
+    return true;
+}
+
+// Stop recording, and remove the recording, when the game turned out
+// to be restored from a save file.
+void replayAbandonRecording() {
+    if (recording == nullptr) {
+        return;
+    }
+
+    (void) fclose(recording);
+    recording = nullptr;
+
+    (void) remove(recording_filename.c_str());
+}
+
+// Each key is flushed out straight away, so a recording of a game which
+// crashes is complete up to the crash.
+static void replayWrite(uint8_t const *bytes, size_t count) {
+    if (fwrite(bytes, count, 1, recording) != 1 || fflush(recording) != 0) {
+        (void) fclose(recording);
+        recording = nullptr;
+    }
+}
+
+// Record a key press returned by getKeyInput().
+void replayRecordKey(char key) {
+    if (recording == nullptr) {
+        return;
+    }
+
+    auto byte = (uint8_t) key;
+    if (byte == REPLAY_ESCAPE) {
+        uint8_t code[] = {REPLAY_ESCAPE, REPLAY_ESCAPE};
+        replayWrite(code, sizeof(code));
+    } else {
+        replayWrite(&byte, 1);
+    }
+}
+
+// Record the result of a checkForNonBlockingKeyPress() poll.
+void replayRecordKeyPressWaiting(bool pressed) {
+    if (recording == nullptr) {
+        return;
+    }
+
+    recording_polls++;
+
+    if (pressed) {
+        uint8_t code[] = {
+            REPLAY_ESCAPE,
+            REPLAY_KEY_PRESS_WAITING,
+            (uint8_t)(recording_polls & 0xFF),
+            (uint8_t)((recording_polls >> 8) & 0xFF),
+            (uint8_t)((recording_polls >> 16) & 0xFF),
+            (uint8_t)((recording_polls >> 24) & 0xFF),
+        };
+        replayWrite(code, sizeof(code));
+    }
+}
+
+// Reads the header of a replay, leaving `playback_pos` at the first key.
+static bool replayReadHeader(uint32_t &seed, bool &wizard, bool &script) {
+    std::string lines[4];
+
+    for (auto &line : lines) {
+        while (playback_pos < playback.size() && playback[playback_pos] != '\n') {
+            line += (char) playback[playback_pos];
+            playback_pos++;
+        }
+        if (playback_pos == playback.size()) {
+            return false;
+        }
+        playback_pos++;
+    }
+
+    unsigned int header_seed = 0;
+    int header_wizard = 0;
+    int header_script = 0;
+
+    if (lines[0] != REPLAY_SIGNATURE || sscanf(lines[1].c_str(), "seed %u", &header_seed) != 1 || sscanf(lines[2].c_str(), "wizard %d", &header_wizard) != 1 ||
+        sscanf(lines[3].c_str(), "script %d", &header_script) != 1) {
+        return false;
+    }
+
+    seed = (uint32_t) header_seed;
+    wizard = header_wizard != 0;
+    script = header_script != 0;
+
+    return true;
+}
+
+// Play back the replay in `filename` with the null UI, until either the
+// game reaches `stop_turn` (-1 for never), or the replay runs out. The
+// game is then handed over to the terminal. Sets the `seed` to start
+// the game with, and whether it is to be played in `wizard` mode.
+bool replayStartPlayback(const std::string &filename, int32_t stop_turn, uint32_t &seed, bool &wizard) {
+    FILE *file = fopen(filename.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+
+    playback.clear();
+    int ch;
+    while ((ch = getc(file)) != EOF) {
+        playback.push_back((uint8_t) ch);
+    }
+    (void) fclose(file);
+
+    playback_pos = 0;
+    bool script = false;
+    if (!replayReadHeader(seed, wizard, script)) {
+        return false;
+    }
+
+    playback_on = true;
+    playback_stop_turn = stop_turn;
+    playback_polls = 0;
+
+    terminalInitializeNullUI(script ? replay_script_key_source : replay_key_source);
+
+    return true;
+}
+
+// When there is no terminal to hand over to, the replay ends the
+// game just as the end of a batch command script does.
+static int replayEndPlayback() {
+    playback_on = false;
+    playback.clear();
+
+#ifndef _WIN32
+    if (isatty(STDIN_FILENO) == 0) {
+        return EOF;
+    }
+#endif
+
+    if (!terminalLeaveNullUI()) {
+        return EOF;
+    }
+
+    return KEY_SOURCE_CHANGED;
+}
+
+static int replayReadKey() {
+    if (!playback_on) {
+        return EOF;
+    }
+
+    if (playback_stop_turn >= 0 && dg.game_turn >= playback_stop_turn) {
+        return replayEndPlayback();
+    }
+
+    if (playback_pos >= playback.size()) {
+        return replayEndPlayback();
+    }
+
+    uint8_t byte = playback[playback_pos++];
+    if (byte != REPLAY_ESCAPE) {
+        return byte;
+    }
+
+    if (playback_pos < playback.size() && playback[playback_pos] == REPLAY_ESCAPE) {
+        playback_pos++;
+        return byte;
+    }
+
+    // A poll code where a key press was expected, so the game is no
+    // longer following the replay, and it is no use going on with it.
+    return replayEndPlayback();
+}
+
+static bool replayKeyPressWaiting() {
+    if (!playback_on) {
+        return false;
+    }
+
+    playback_polls++;
+
+    if (playback.size() - playback_pos < 6 || playback[playback_pos] != REPLAY_ESCAPE || playback[playback_pos + 1] != REPLAY_KEY_PRESS_WAITING) {
+        return false;
+    }
+
+    uint32_t poll = playback[playback_pos + 2] | (playback[playback_pos + 3] << 8) | (playback[playback_pos + 4] << 16) | ((uint32_t) playback[playback_pos + 5] << 24);
+    if (poll != playback_polls) {
+        return false;
+    }
+
+    playback_pos += 6;
+
+    return true;
+}
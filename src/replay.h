@@ -0,0 +1,16 @@
+// Copyright (c) 1981-86 Robert A. Koeneke
+// Copyright (c) 1987-94 James E. Wilson
+//
+// This work is free software released under the GNU General Public License
+// version 2.0, and comes with ABSOLUTELY NO WARRANTY.
+//
+// See LICENSE and AUTHORS for more information.
+
+#pragma once
+
+bool replayStartRecording(const std::string &filename, uint32_t seed, bool wizard, bool script);
+void replayAbandonRecording();
+void replayRecordKey(char key);
+void replayRecordKeyPressWaiting(bool pressed);
+
+bool replayStartPlayback(const std::string &filename, int32_t stop_turn, uint32_t &seed, bool &wizard);
@@ -65,30 +65,132 @@ constexpr int32_t RNG_A = 16807L;
 constexpr int32_t RNG_Q = RNG_M / RNG_A; // m div a 127773L
 constexpr int32_t RNG_R = RNG_M % RNG_A; // m mod a 2836L
 
-// 32 bit seed
-static uint32_t rnd_seed;
-
-uint32_t getRandomSeed() {
-    return rnd_seed;
-}
-
-void setRandomSeed(uint32_t seed) {
+void Rng_t::setSeed(uint32_t seed) {
     // set seed to value between 1 and m-1
-    rnd_seed = (uint32_t)((seed % (RNG_M - 1)) + 1);
+    state = (uint32_t)((seed % (RNG_M - 1)) + 1);
 }
 
 // returns a pseudo-random number from set 1, 2, ..., RNG_M - 1
-int32_t rnd() {
-    auto high = (int32_t)(rnd_seed / RNG_Q);
-    auto low = (int32_t)(rnd_seed % RNG_Q);
+int32_t Rng_t::next() {
+    auto high = (int32_t)(state / RNG_Q);
+    auto low = (int32_t)(state % RNG_Q);
     auto test = (int32_t)(RNG_A * low - RNG_R * high);
 
     if (test > 0) {
-        rnd_seed = (uint32_t) test;
+        state = (uint32_t) test;
     } else {
-        rnd_seed = (uint32_t)(test + RNG_M);
+        state = (uint32_t)(test + RNG_M);
+    }
+    return state;
+}
+
+// Returns x mod m for any x below 2^62, without a division: as m is
+// 2^31 - 1, the bits above the lowest 31 can be added back in at the bottom.
+static uint64_t rngModulus(uint64_t x) {
+    x = (x & RNG_M) + (x >> 31);
+    x = (x & RNG_M) + (x >> 31);
+    return x >= (uint64_t) RNG_M ? x - RNG_M : x;
+}
+
+// a^n mod m
+static constexpr uint64_t rngMultiplierPower(int n) {
+    uint64_t multiplier = 1;
+    for (int i = 0; i < n; i++) {
+        multiplier = multiplier * RNG_A % RNG_M;
+    }
+    return multiplier;
+}
+
+// The numbers are made in lanes which each step `RNG_LANES` places at a
+// time, by a single multiply with a^RNG_LANES. The lanes don't depend on
+// each other, so the compiler can run them side by side in vector registers.
+constexpr int RNG_LANES = 4;
+constexpr uint64_t RNG_A_LANES = rngMultiplierPower(RNG_LANES);
+
+void Rng_t::fill(int32_t *values, int count) {
+    if (count < 2 * RNG_LANES) {
+        for (int i = 0; i < count; i++) {
+            values[i] = next();
+        }
+        return;
+    }
+
+    uint64_t lanes[RNG_LANES];
+    for (int lane = 0; lane < RNG_LANES; lane++) {
+        values[lane] = next();
+        lanes[lane] = (uint64_t) values[lane];
+    }
+
+    int i = RNG_LANES;
+    for (; i + RNG_LANES <= count; i += RNG_LANES) {
+        for (int lane = 0; lane < RNG_LANES; lane++) {
+            lanes[lane] = rngModulus(lanes[lane] * RNG_A_LANES);
+            values[i + lane] = (int32_t) lanes[lane];
+        }
+    }
+    state = (uint32_t) values[i - 1];
+
+    for (; i < count; i++) {
+        values[i] = next();
+    }
+}
+
+// Each step multiplies the state by a (mod m), so `steps` of them
+// multiply it by a^steps (mod m), found here by repeated squaring.
+// Both factors are below 2^31, so their product fits in 64 bits.
+void Rng_t::jump(uint64_t steps) {
+    uint64_t multiplier = 1;
+    uint64_t square = RNG_A;
+
+    while (steps != 0) {
+        if ((steps & 1) != 0) {
+            multiplier = multiplier * square % RNG_M;
+        }
+        square = square * square % RNG_M;
+        steps >>= 1;
     }
-    return rnd_seed;
+
+    state = (uint32_t)(state * multiplier % RNG_M);
+}
+
+// The new seed is scrambled, as a seed taken straight from this stream
+// would only give this stream again, one number behind.
+Rng_t Rng_t::split() {
+    auto seed = (uint32_t) next();
+
+    seed ^= seed >> 16;
+    seed *= 0x45d9f3bU;
+    seed ^= seed >> 16;
+
+    return Rng_t(seed);
+}
+
+RngStreams_t rng_streams;
+
+static thread_local Rng_t *rng_in_use = &rng_streams.main;
+
+RngStreamScope_t::RngStreamScope_t(Rng_t &rng) : previous(rng_in_use) {
+    rng_in_use = &rng;
+}
+
+RngStreamScope_t::~RngStreamScope_t() {
+    rng_in_use = previous;
+}
+
+uint32_t getRandomSeed() {
+    return rng_in_use->getSeed();
+}
+
+void setRandomSeed(uint32_t seed) {
+    rng_in_use->setSeed(seed);
+}
+
+int32_t rnd() {
+    return rng_in_use->next();
+}
+
+void rndFill(int32_t *values, int count) {
+    rng_in_use->fill(values, count);
 }
 
 #ifdef TEST_RNG
@@ -8,7 +8,68 @@
 
 #pragma once
 
-// rng.cpp
+// Rng_t is a single stream of the Park and Miller random number generator
+// (see rng.cpp). Any number of them can be used side by side, each one
+// giving the same numbers for the same seed no matter what the others do.
+class Rng_t {
+public:
+    Rng_t() : state(1) {}
+    explicit Rng_t(uint32_t seed) : state(0) { setSeed(seed); }
+
+    uint32_t getSeed() const { return state; }
+    void setSeed(uint32_t seed);
+
+    // Returns the next number of the stream, from 1 to 2^31-2
+    int32_t next();
+
+    // Fills `values` with the next `count` numbers of the stream, the same
+    // numbers as that many calls of next(), only made in a batch.
+    void fill(int32_t *values, int count);
+
+    // Returns a number from 1 to `max`, as randomNumber() does
+    int randomNumber(int max) { return (next() % max) + 1; }
+
+    // Moves the stream `steps` numbers ahead, in log(steps) time.
+    void jump(uint64_t steps);
+
+    // Returns a new stream seeded from this one. Streams split off in the
+    // same order from the same seed get the same numbers, so the work
+    // handed to each can be done on any thread and still give one result.
+    Rng_t split();
+
+private:
+    uint32_t state;
+};
+
+// The streams of random numbers used by the game. Each subsystem draws from
+// a stream of its own, so how many numbers one of them uses doesn't change
+// the numbers another will get.
+typedef struct {
+    Rng_t main{};
+    Rng_t monsters{}; // monster movement and spells
+    Rng_t combat{};   // melee blows, by the player and by monsters
+    Rng_t stores{};   // store owners, stock and haggling
+} RngStreams_t;
+
+extern RngStreams_t rng_streams;
+
+// Makes `rng` the stream rnd() and randomNumber() draw from, until the end
+// of the enclosing scope. The stream in use is per thread, and a thread
+// starts out on `rng_streams.main`.
+class RngStreamScope_t {
+public:
+    explicit RngStreamScope_t(Rng_t &rng);
+    ~RngStreamScope_t();
+
+    RngStreamScope_t(RngStreamScope_t const &) = delete;
+    RngStreamScope_t &operator=(RngStreamScope_t const &) = delete;
+
+private:
+    Rng_t *previous;
+};
+
+// rng.cpp, these use the stream in use
 uint32_t getRandomSeed();
 void setRandomSeed(uint32_t seed);
 int32_t rnd();
+void rndFill(int32_t *values, int count);
@@ -10,6 +10,7 @@
 
 #include "headers.h"
 #include "version.h"
+#include <vector>
 
 // High score file pointer
 FILE *highscore_fp;
@@ -21,6 +22,277 @@ static uint8_t highScoreGenderLabel() {
     return 'F';
 }
 
+// The score file is a fixed size table, shared by every game on the system
+// and updated in place through mmap():
+//
+//   header   ScoreTableHeader_t
+//   records  HighScore_t[MAX_HIGH_SCORE_ENTRIES], in order of arrival
+//   ranking  uint16_t[MAX_HIGH_SCORE_ENTRIES], record numbers by descending points
+//
+// A new score is written to a single record, and its rank found with a
+// binary search of the ranking. Only the ranking entries below it move, the
+// other records are never rewritten. Writers hold a fcntl() write lock on
+// the file while updating it, readers a read lock.
+//
+// Score files in the older format (three version bytes followed by the
+// xor_byte encoded entries) are converted the first time they are opened.
+constexpr uint8_t SCORE_TABLE_SIGNATURE[] = {'U', 'M', 'H', 'S'};
+
+typedef struct {
+    uint8_t signature[4];
+    uint8_t version_maj;
+    uint8_t version_min;
+    uint8_t patch_level;
+    uint8_t unused;
+    uint16_t total; // Records in use
+    uint16_t unused_too;
+} ScoreTableHeader_t;
+
+typedef struct {
+    ScoreTableHeader_t header;
+    HighScore_t records[MAX_HIGH_SCORE_ENTRIES];
+    uint16_t ranking[MAX_HIGH_SCORE_ENTRIES];
+} ScoreTable_t;
+
+static bool scoreTableLock(short lock_type) {
+#ifdef _WIN32
+    (void) lock_type;
+    return true;
+#else
+    struct flock lock {};
+    lock.l_type = lock_type;
+    lock.l_whence = SEEK_SET;
+    lock.l_start = 0;
+    lock.l_len = 0; // the whole file
+
+    while (fcntl(fileno(highscore_fp), F_SETLKW, &lock) == -1) {
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+static void scoreTableUnlock() {
+#ifndef _WIN32
+    (void) scoreTableLock(F_UNLCK);
+#endif
+}
+
+// Note: the score file stream is unbuffered (see initializeScoreFile()),
+// so reads always see what other games have written.
+static bool scoreTableIsCurrentFormat() {
+    struct stat file_info {};
+    if (fstat(fileno(highscore_fp), &file_info) != 0 || file_info.st_size != (off_t) sizeof(ScoreTable_t)) {
+        return false;
+    }
+
+    uint8_t signature[sizeof(SCORE_TABLE_SIGNATURE)];
+
+    (void) fseek(highscore_fp, (long) 0, SEEK_SET);
+    return fread(signature, sizeof(signature), 1, highscore_fp) == 1 && memcmp(signature, SCORE_TABLE_SIGNATURE, sizeof(signature)) == 0;
+}
+
+// Maps the score file into memory, extending it to the size of the table
+// if needed. Windows has no mmap(), so there the table is read into memory,
+// and written back by scoreTableUnmap().
+static ScoreTable_t *scoreTableMap(bool writable) {
+#ifdef _WIN32
+    auto table = new ScoreTable_t{};
+    (void) fseek(highscore_fp, (long) 0, SEEK_SET);
+    (void) fread(table, sizeof(ScoreTable_t), 1, highscore_fp);
+    (void) writable;
+    return table;
+#else
+    int fd = fileno(highscore_fp);
+
+    if (writable && ftruncate(fd, (off_t) sizeof(ScoreTable_t)) != 0) {
+        return nullptr;
+    }
+
+    int protection = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *table = mmap(nullptr, sizeof(ScoreTable_t), protection, MAP_SHARED, fd, 0);
+
+    return table == MAP_FAILED ? nullptr : (ScoreTable_t *) table;
+#endif
+}
+
+static void scoreTableUnmap(ScoreTable_t *table, bool writable) {
+#ifdef _WIN32
+    if (writable) {
+        (void) fseek(highscore_fp, (long) 0, SEEK_SET);
+        (void) fwrite(table, sizeof(ScoreTable_t), 1, highscore_fp);
+        (void) fflush(highscore_fp);
+    }
+    delete table;
+#else
+    (void) writable;
+    (void) munmap(table, sizeof(ScoreTable_t));
+#endif
+}
+
+// Rewrites an empty or old format score file as a score table, the caller
+// must hold the write lock. Returns false if the old scores are from a
+// different version of the game.
+static bool scoreTableConvert() {
+    (void) fseek(highscore_fp, (long) 0, SEEK_SET);
+
+    // Read version numbers from the score file, and check for validity.
+    auto version_maj = (uint8_t) getc(highscore_fp);
+    auto version_min = (uint8_t) getc(highscore_fp);
+    auto patch_level = (uint8_t) getc(highscore_fp);
+
+    bool empty = feof(highscore_fp) != 0;
+    if (!empty && !validGameVersion(version_maj, version_min, patch_level)) {
+        return false;
+    }
+
+    // set the static fileptr in save.c to the high score file pointer
+    setFileptr(highscore_fp);
+
+    HighScore_t old_entries[MAX_HIGH_SCORE_ENTRIES];
+    int total = 0;
+
+    while (!empty && total < MAX_HIGH_SCORE_ENTRIES) {
+        readHighScore(old_entries[total]);
+        if (feof(highscore_fp) != 0) {
+            break;
+        }
+        total++;
+    }
+
+    ScoreTable_t *table = scoreTableMap(true);
+    if (table == nullptr) {
+        return false;
+    }
+
+    *table = ScoreTable_t{};
+    (void) memcpy(table->header.signature, SCORE_TABLE_SIGNATURE, sizeof(SCORE_TABLE_SIGNATURE));
+    table->header.version_maj = CURRENT_VERSION_MAJOR;
+    table->header.version_min = CURRENT_VERSION_MINOR;
+    table->header.patch_level = CURRENT_VERSION_PATCH;
+    table->header.total = (uint16_t) total;
+
+    // the old format is already in order of rank
+    for (int i = 0; i < total; i++) {
+        table->records[i] = old_entries[i];
+        table->ranking[i] = (uint16_t) i;
+    }
+
+    scoreTableUnmap(table, true);
+
+    return true;
+}
+
+// Locks and maps the score table, converting the score file first if needed.
+// Returns nullptr if the score file can not be used, in which case it is
+// already unlocked.
+static ScoreTable_t *scoreTableOpen(bool writable) {
+    if (!scoreTableLock(writable ? F_WRLCK : F_RDLCK)) {
+        return nullptr;
+    }
+
+    if (!scoreTableIsCurrentFormat()) {
+        // the conversion needs the write lock, even when only reading
+        if (!scoreTableLock(F_WRLCK) || (!scoreTableIsCurrentFormat() && !scoreTableConvert())) {
+            scoreTableUnlock();
+            return nullptr;
+        }
+    }
+
+    ScoreTable_t *table = scoreTableMap(writable);
+    if (table == nullptr) {
+        scoreTableUnlock();
+        return nullptr;
+    }
+
+    if (!validGameVersion(table->header.version_maj, table->header.version_min, table->header.patch_level) || table->header.total > MAX_HIGH_SCORE_ENTRIES) {
+        scoreTableUnmap(table, false);
+        scoreTableUnlock();
+        return nullptr;
+    }
+
+    return table;
+}
+
+static void scoreTableClose(ScoreTable_t *table, bool writable) {
+    scoreTableUnmap(table, writable);
+    scoreTableUnlock();
+}
+
+// under unix, only allow one gender/race/class combo per person,
+// on single user system, allow any number of entries, but try to
+// prevent multiple entries per character by checking for case when
+// birth_date/gender/race/class are the same, and game.character_died_from
+// of score file entry is "(saved)"
+static bool highScoreIsSameCharacter(HighScore_t const &new_entry, HighScore_t const &old_entry) {
+    return ((new_entry.uid != 0 && new_entry.uid == old_entry.uid) ||
+            (new_entry.uid == 0 && (strcmp(old_entry.died_from, "(saved)") == 0) && new_entry.birth_date == old_entry.birth_date)) &&
+           new_entry.gender == old_entry.gender && new_entry.race == old_entry.race && new_entry.character_class == old_entry.character_class;
+}
+
+// Returns the rank a score of `points` gets, ahead of any equal scores.
+static int highScoreRankFor(ScoreTable_t const &table, int32_t points) {
+    int low = 0;
+    int high = table.header.total;
+
+    while (low < high) {
+        int middle = (low + high) / 2;
+
+        if (table.records[table.ranking[middle]].points > points) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+// Writes `new_entry` into the score table at its rank. If the same character
+// already has a lower score in the table, that record is reused, otherwise
+// a free record is used, or the lowest ranked one once the table is full.
+static void highScoreInsert(ScoreTable_t &table, HighScore_t const &new_entry) {
+    int rank = highScoreRankFor(table, new_entry.points);
+
+    // only allow one thousand scores in the score file
+    if (rank >= MAX_HIGH_SCORE_ENTRIES) {
+        return;
+    }
+
+    // Exit without saving when this character already has a better score.
+    for (int i = 0; i < rank; i++) {
+        if (highScoreIsSameCharacter(new_entry, table.records[table.ranking[i]])) {
+            return;
+        }
+    }
+
+    int last = table.header.total;
+    for (int i = rank; i < table.header.total; i++) {
+        if (highScoreIsSameCharacter(new_entry, table.records[table.ranking[i]])) {
+            last = i;
+            break;
+        }
+    }
+
+    if (last == MAX_HIGH_SCORE_ENTRIES) {
+        last--;
+    }
+
+    uint16_t record;
+    if (last == table.header.total) {
+        record = table.header.total++;
+    } else {
+        record = table.ranking[last];
+    }
+
+    table.records[record] = new_entry;
+
+    (void) memmove(&table.ranking[rank + 1], &table.ranking[rank], (last - rank) * sizeof(uint16_t));
+    table.ranking[rank] = record;
+}
+
 // Enters a players name on the top twenty list -JWT-
 void recordNewHighScore() {
     clearScreen();
@@ -59,159 +331,47 @@ void recordNewHighScore() {
     }
     (void) strcpy(new_entry.died_from, tmp);
 
-    if ((highscore_fp = fopen(config::files::scores.c_str(), "rb+")) == nullptr) {
-        printMessage(("Error opening score file '" + config::files::scores + "'.").c_str());
-        printMessage(CNIL);
+    // No need to print a message if the score file can not be used,
+    // a subsequent call to showScoresScreen() will print a message.
+    ScoreTable_t *table = scoreTableOpen(true);
+    if (table == nullptr) {
         return;
     }
 
-    // Search file to find where to insert this character, if uid != 0 and
-    // find same uid/gender/race/class combo then exit without saving this score.
-    // Seek to the beginning of the file just to be safe.
-    (void) fseek(highscore_fp, (long) 0, SEEK_SET);
-
-    // Read version numbers from the score file, and check for validity.
-    auto version_maj = (uint8_t) getc(highscore_fp);
-    auto version_min = (uint8_t) getc(highscore_fp);
-    auto patch_level = (uint8_t) getc(highscore_fp);
-
-    // If this is a new score file, it should be empty.
-    // Write the current version numbers to the score file.
-    if (feof(highscore_fp) != 0) {
-        // Seek to the beginning of the file just to be safe.
-        (void) fseek(highscore_fp, (long) 0, SEEK_SET);
+    highScoreInsert(*table, new_entry);
 
-        (void) putc(CURRENT_VERSION_MAJOR, highscore_fp);
-        (void) putc(CURRENT_VERSION_MINOR, highscore_fp);
-        (void) putc(CURRENT_VERSION_PATCH, highscore_fp);
-
-        // must fseek() before can change read/write mode
-        (void) fseek(highscore_fp, (long) 0, SEEK_CUR);
-    } else if (!validGameVersion(version_maj, version_min, patch_level)) {
-        // No need to print a message, a subsequent call to
-        // showScoresScreen() will print a message.
-        (void) fclose(highscore_fp);
-        return;
-    }
-
-    // set the static fileptr in save.c to the high score file pointer
-    setFileptr(highscore_fp);
-
-    HighScore_t old_entry{};
-    HighScore_t entry{};
-
-    int i = 0;
-    off_t curpos = ftell(highscore_fp);
-    readHighScore(old_entry);
-
-    while (feof(highscore_fp) == 0) {
-        if (new_entry.points >= old_entry.points) {
-            break;
-        }
-
-        // under unix, only allow one gender/race/class combo per person,
-        // on single user system, allow any number of entries, but try to
-        // prevent multiple entries per character by checking for case when
-        // birthdate/gender/race/class are the same, and game.character_died_from
-        // of score file entry is "(saved)"
-        if (((new_entry.uid != 0 && new_entry.uid == old_entry.uid) ||
-             (new_entry.uid == 0 && (strcmp(old_entry.died_from, "(saved)") == 0) && new_entry.birth_date == old_entry.birth_date)) &&
-            new_entry.gender == old_entry.gender && new_entry.race == old_entry.race && new_entry.character_class == old_entry.character_class) {
-            (void) fclose(highscore_fp);
-            return;
-        }
-
-        // only allow one thousand scores in the score file
-        i++;
-        if (i >= MAX_HIGH_SCORE_ENTRIES) {
-            (void) fclose(highscore_fp);
-            return;
-        }
-
-        curpos = ftell(highscore_fp);
-        readHighScore(old_entry);
-    }
-
-    if (feof(highscore_fp) != 0) {
-        // write out new_entry at end of file
-        (void) fseek(highscore_fp, curpos, SEEK_SET);
-
-        saveHighScore(new_entry);
-    } else {
-        entry = new_entry;
-
-        while (feof(highscore_fp) == 0) {
-            (void) fseek(highscore_fp, -(long) sizeof(HighScore_t) - (long) sizeof(char), SEEK_CUR);
-
-            saveHighScore(entry);
-
-            // under unix, only allow one gender/race/class combo per person,
-            // on single user system, allow any number of entries, but try to
-            // prevent multiple entries per character by checking for case when
-            // birth_date/gender/race/class are the same, and game.character_died_from
-            // of score file entry is "(saved)"
-            if (((new_entry.uid != 0 && new_entry.uid == old_entry.uid) ||
-                 (new_entry.uid == 0 && (strcmp(old_entry.died_from, "(saved)") == 0) && new_entry.birth_date == old_entry.birth_date)) &&
-                new_entry.gender == old_entry.gender && new_entry.race == old_entry.race && new_entry.character_class == old_entry.character_class) {
-                break;
-            }
-            entry = old_entry;
-
-            // must fseek() before can change read/write mode
-            (void) fseek(highscore_fp, (long) 0, SEEK_CUR);
-
-            curpos = ftell(highscore_fp);
-            readHighScore(old_entry);
-        }
-        if (feof(highscore_fp) != 0) {
-            (void) fseek(highscore_fp, curpos, SEEK_SET);
-
-            saveHighScore(entry);
-        }
-    }
-
-    (void) fclose(highscore_fp);
+    scoreTableClose(table, true);
 }
 
 void showScoresScreen() {
-    if ((highscore_fp = fopen(config::files::scores.c_str(), "rb")) == nullptr) {
-        printMessage(("Error opening score file '" + config::files::scores + "'.").c_str());
+    ScoreTable_t *table = scoreTableOpen(false);
+    if (table == nullptr) {
+        printMessage(("Sorry. The score file '" + config::files::scores + "' can not be read, or is from a different version of umoria.").c_str());
         printMessage(CNIL);
         return;
     }
 
-    (void) fseek(highscore_fp, (off_t) 0, SEEK_SET);
-
-    // Read version numbers from the score file, and check for validity.
-    auto version_maj = (uint8_t) getc(highscore_fp);
-    auto version_min = (uint8_t) getc(highscore_fp);
-    auto patch_level = (uint8_t) getc(highscore_fp);
-
-    // If score data present, check if a valid game version
-    if (feof(highscore_fp) == 0 && !validGameVersion(version_maj, version_min, patch_level)) {
-        printMessage("Sorry. This score file is from a different version of umoria.");
-        printMessage(CNIL);
-        (void) fclose(highscore_fp);
-        return;
+    // Copy the scores out, so the lock is not held while waiting for key presses.
+    int total = table->header.total;
+    std::vector<HighScore_t> scores((size_t) total);
+    for (int i = 0; i < total; i++) {
+        scores[i] = table->records[table->ranking[i]];
     }
 
-    // set the static fileptr in save.c to the high score file pointer
-    setFileptr(highscore_fp);
-
-    HighScore_t score{};
-    readHighScore(score);
+    scoreTableClose(table, false);
 
     char input;
     char msg[100];
 
-    int i = 0;
     int rank = 1;
 
-    while (feof(highscore_fp) == 0) {
-        i = 1;
+    while (rank <= total) {
+        int i = 1;
         clearScreen();
         // Put twenty scores on each page, on lines 2 through 21.
-        while ((feof(highscore_fp) == 0) && i < 21) {
+        while (rank <= total && i < 21) {
+            HighScore_t const &score = scores[(size_t)(rank - 1)];
+
             (void) sprintf(msg,                                               //
                            "%-4d%8d %-19.19s %c %-10.10s %-7.7s%3d %-22.22s", //
                            rank,                                              //
@@ -226,7 +386,6 @@ void showScoresScreen() {
             i++;
             putStringClearToEOL(msg, Coord_t{i, 0});
             rank++;
-            readHighScore(score);
         }
         putStringClearToEOL("Rank  Points Name              Sex Race       Class  Lvl Killed By", Coord_t{0, 0});
         eraseLine(Coord_t{1, 0});
@@ -236,8 +395,6 @@ void showScoresScreen() {
             break;
         }
     }
-
-    (void) fclose(highscore_fp);
 }
 
 // Calculates the total number of points earned -JWT-
@@ -11,7 +11,7 @@
 #include <cstdint>
 
 // HighScore_t is a score object used for saving to the high score file
-// This structure is 64 bytes in size
+// This structure is 72 bytes in size, and is stored as is in the score table
 typedef struct {
     int32_t points;
     int32_t birth_date;
@@ -33,8 +33,8 @@ constexpr uint16_t MAX_HIGH_SCORE_ENTRIES = 1000;
 
 extern FILE *highscore_fp;
 
-// TODO: these are implemented in `game_save.cpp` so need moving.
-void saveHighScore(HighScore_t const &score);
+// TODO: this is implemented in `game_save.cpp` so needs moving.
+// Only used to convert score files from before the score table format.
 void readHighScore(HighScore_t &score);
 
 void recordNewHighScore();
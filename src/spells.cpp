@@ -160,7 +160,7 @@ bool spellDetectTreasureWithinVicinity() {
 
     for (coord.y = dg.panel.top; coord.y <= dg.panel.bottom; coord.y++) {
         for (coord.x = dg.panel.left; coord.x <= dg.panel.right; coord.x++) {
-            Tile_t &tile = dg.floor[coord.y][coord.x];
+            Tile_t tile = dg.floor[coord.y][coord.x];
 
             if (tile.treasure_id != 0 && game.treasure.list[tile.treasure_id].category_id == TV_GOLD && !caveTileVisible(coord)) {
                 tile.field_mark = true;
@@ -181,7 +181,7 @@ bool spellDetectObjectsWithinVicinity() {
 
     for (coord.y = dg.panel.top; coord.y <= dg.panel.bottom; coord.y++) {
         for (coord.x = dg.panel.left; coord.x <= dg.panel.right; coord.x++) {
-            Tile_t &tile = dg.floor[coord.y][coord.x];
+            Tile_t tile = dg.floor[coord.y][coord.x];
 
             if (tile.treasure_id != 0 && game.treasure.list[tile.treasure_id].category_id < TV_MAX_OBJECT && !caveTileVisible(coord)) {
                 tile.field_mark = true;
@@ -202,7 +202,7 @@ bool spellDetectTrapsWithinVicinity() {
 
     for (coord.y = dg.panel.top; coord.y <= dg.panel.bottom; coord.y++) {
         for (coord.x = dg.panel.left; coord.x <= dg.panel.right; coord.x++) {
-            Tile_t &tile = dg.floor[coord.y][coord.x];
+            Tile_t tile = dg.floor[coord.y][coord.x];
 
             if (tile.treasure_id == 0) {
                 continue;
@@ -230,7 +230,7 @@ bool spellDetectSecretDoorssWithinVicinity() {
 
     for (coord.y = dg.panel.top; coord.y <= dg.panel.bottom; coord.y++) {
         for (coord.x = dg.panel.left; coord.x <= dg.panel.right; coord.x++) {
-            Tile_t &tile = dg.floor[coord.y][coord.x];
+            Tile_t tile = dg.floor[coord.y][coord.x];
 
             if (tile.treasure_id == 0) {
                 continue;
@@ -259,11 +259,15 @@ bool spellDetectSecretDoorssWithinVicinity() {
 bool spellDetectInvisibleCreaturesWithinVicinity() {
     bool detected = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
-        Monster_t &monster = monsters[id];
+    int16_t ids[MON_TOTAL_ALLOCATIONS];
+    int count = monsterIndexQuery(Coord_t{dg.panel.top, dg.panel.left}, Coord_t{dg.panel.bottom, dg.panel.right}, ids);
+
+    for (int i = 0; i < count; i++) {
+        Monster_t &monster = monsters[ids[i]];
 
-        if (coordInsidePanel(Coord_t{monster.pos.y, monster.pos.x}) && ((creatures_list[monster.creature_id].movement & config::monsters::move::CM_INVISIBLE) != 0u)) {
+        if ((creatures_list[monster.creature_id].movement & config::monsters::move::CM_INVISIBLE) != 0u) {
             monster.lit = true;
+            monsterScheduleWake(ids[i]);
 
             // works correctly even if hallucinating
             panelPutTile((char) creatures_list[monster.creature_id].sprite, Coord_t{monster.pos.y, monster.pos.x});
@@ -325,9 +329,14 @@ bool spellDarkenArea(Coord_t coord) {
         int end_row = start_row + half_height - 1;
         int end_col = start_col + half_width - 1;
 
-        for (spot.y = start_row; spot.y <= end_row; spot.y++) {
-            for (spot.x = start_col; spot.x <= end_col; spot.x++) {
-                Tile_t &tile = dg.floor[spot.y][spot.x];
+        // only the parts of the rooms within the area need to be looked at
+        Coord_t top_left = Coord_t{start_row, start_col};
+        Coord_t bottom_right = Coord_t{end_row, end_col};
+        bool has_room_tiles = dungeonRoomTilesWithin(top_left, bottom_right);
+
+        for (spot.y = top_left.y; has_room_tiles && spot.y <= bottom_right.y; spot.y++) {
+            for (spot.x = top_left.x; spot.x <= bottom_right.x; spot.x++) {
+                Tile_t tile = dg.floor[spot.y][spot.x];
 
                 if (tile.perma_lit_room && tile.feature_id <= MAX_CAVE_FLOOR) {
                     tile.permanent_light = false;
@@ -344,12 +353,14 @@ bool spellDarkenArea(Coord_t coord) {
     } else {
         for (spot.y = coord.y - 1; spot.y <= coord.y + 1; spot.y++) {
             for (spot.x = coord.x - 1; spot.x <= coord.x + 1; spot.x++) {
-                Tile_t &tile = dg.floor[spot.y][spot.x];
+                Tile_t tile = dg.floor[spot.y][spot.x];
 
                 if (tile.feature_id == TILE_CORR_FLOOR && tile.permanent_light) {
                     // permanent_light could have been set by star-lite wand, etc
                     tile.permanent_light = false;
                     darkened = true;
+
+                    dungeonLiteSpot(spot);
                 }
             }
         }
@@ -367,7 +378,7 @@ static void dungeonLightAreaAroundFloorTile(Coord_t coord) {
 
     for (spot.y = coord.y - 1; spot.y <= coord.y + 1; spot.y++) {
         for (spot.x = coord.x - 1; spot.x <= coord.x + 1; spot.x++) {
-            Tile_t &tile = dg.floor[spot.y][spot.x];
+            Tile_t tile = dg.floor[spot.y][spot.x];
 
             if (tile.feature_id >= MIN_CAVE_WALL) {
                 tile.permanent_light = true;
@@ -431,11 +442,17 @@ bool spellAggravateMonsters(int affect_distance) {
     bool aggravated = false;
 
     for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+        if (!monsterIsAllocated(id)) {
+            continue;
+        }
+
         Monster_t &monster = monsters[id];
         monster.sleep_count = 0;
+        monsterScheduleWake(id);
 
         if (monster.distance_from_player <= affect_distance && monster.speed < 2) {
             monster.speed++;
+            monsterScheduleSpeedChanged(id);
             aggravated = true;
         }
     }
@@ -496,7 +513,7 @@ bool spellSurroundPlayerWithDoors() {
                 continue;
             }
 
-            Tile_t &tile = dg.floor[coord.y][coord.x];
+            Tile_t tile = dg.floor[coord.y][coord.x];
 
             if (tile.feature_id <= MAX_CAVE_FLOOR) {
                 if (tile.treasure_id != 0) {
@@ -558,11 +575,15 @@ bool spellDestroyAdjacentDoorsTraps() {
 bool spellDetectMonsters() {
     bool detected = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
-        Monster_t &monster = monsters[id];
+    int16_t ids[MON_TOTAL_ALLOCATIONS];
+    int count = monsterIndexQuery(Coord_t{dg.panel.top, dg.panel.left}, Coord_t{dg.panel.bottom, dg.panel.right}, ids);
+
+    for (int i = 0; i < count; i++) {
+        Monster_t &monster = monsters[ids[i]];
 
-        if (coordInsidePanel(Coord_t{monster.pos.y, monster.pos.x}) && (creatures_list[monster.creature_id].movement & config::monsters::move::CM_INVISIBLE) == 0) {
+        if ((creatures_list[monster.creature_id].movement & config::monsters::move::CM_INVISIBLE) == 0) {
             monster.lit = true;
+            monsterScheduleWake(ids[i]);
             detected = true;
 
             // works correctly even if hallucinating
@@ -613,7 +634,7 @@ void spellLightLine(Coord_t coord, int direction) {
     Coord_t tmp_coord = Coord_t{0, 0};
 
     while (!finished) {
-        Tile_t &tile = dg.floor[coord.y][coord.x];
+        Tile_t tile = dg.floor[coord.y][coord.x];
 
         if (distance > config::treasure::OBJECT_BOLTS_MAX_RANGE || tile.feature_id >= MIN_CLOSED_SPACE) {
             (void) playerMovePosition(direction, coord);
@@ -669,15 +690,15 @@ bool spellDisarmAllInDirection(Coord_t coord, int direction) {
     int distance = 0;
     bool disarmed = false;
 
-    Tile_t *tile = nullptr;
+    bool open_space = false;
 
     do {
-        tile = &dg.floor[coord.y][coord.x];
+        Tile_t tile = dg.floor[coord.y][coord.x];
 
         // note, must continue up to and including the first non open space,
         // because secret doors have feature_id greater than MAX_OPEN_SPACE
-        if (tile->treasure_id != 0) {
-            Inventory_t &item = game.treasure.list[tile->treasure_id];
+        if (tile.treasure_id != 0) {
+            Inventory_t &item = game.treasure.list[tile.treasure_id];
 
             if (item.category_id == TV_INVIS_TRAP || item.category_id == TV_VIS_TRAP) {
                 if (dungeonDeleteObject(coord)) {
@@ -687,7 +708,7 @@ bool spellDisarmAllInDirection(Coord_t coord, int direction) {
                 // Locked or jammed doors become merely closed.
                 item.misc_use = 0;
             } else if (item.category_id == TV_SECRET_DOOR) {
-                tile->field_mark = true;
+                tile.field_mark = true;
                 trapChangeVisibility(coord);
                 disarmed = true;
             } else if (item.category_id == TV_CHEST && item.flags != 0) {
@@ -701,11 +722,13 @@ bool spellDisarmAllInDirection(Coord_t coord, int direction) {
             }
         }
 
+        open_space = tile.feature_id <= MAX_OPEN_SPACE;
+
         // move must be at end because want to light up current spot
         (void) playerMovePosition(direction, coord);
 
         distance++;
-    } while (distance <= config::treasure::OBJECT_BOLTS_MAX_RANGE && tile->feature_id <= MAX_OPEN_SPACE);
+    } while (distance <= config::treasure::OBJECT_BOLTS_MAX_RANGE && open_space);
 
     return disarmed;
 }
@@ -753,6 +776,63 @@ static void spellGetAreaAffectFlags(int spell_type, uint32_t &weapon_type, int &
     }
 }
 
+// The tiles within the radius 2 of a ball or breath exploding at a tile, as
+// offsets from that tile, a row at a time from the top, so they are hit in
+// the same order as ever. Each has its coordDistanceBetween() from the centre,
+// and the tiles which los() from the centre passes through to reach it. This
+// close in those are never more than two tiles, all next to the centre.
+typedef struct {
+    Coord_t offset;
+    int distance;
+    int occluder_count;
+    Coord_t occluders[2];
+} AreaAffectTile_t;
+
+static AreaAffectTile_t const area_affect_stencil[] = {
+    {{-2, -1}, 2, 2, {{-1, 0}, {-1, -1}}},
+    {{-2, 0}, 2, 1, {{-1, 0}, {0, 0}}},
+    {{-2, 1}, 2, 2, {{-1, 0}, {-1, 1}}},
+    {{-1, -2}, 2, 2, {{0, -1}, {-1, -1}}},
+    {{-1, -1}, 1, 0, {{0, 0}, {0, 0}}},
+    {{-1, 0}, 1, 0, {{0, 0}, {0, 0}}},
+    {{-1, 1}, 1, 0, {{0, 0}, {0, 0}}},
+    {{-1, 2}, 2, 2, {{0, 1}, {-1, 1}}},
+    {{0, -2}, 2, 1, {{0, -1}, {0, 0}}},
+    {{0, -1}, 1, 0, {{0, 0}, {0, 0}}},
+    {{0, 0}, 0, 0, {{0, 0}, {0, 0}}},
+    {{0, 1}, 1, 0, {{0, 0}, {0, 0}}},
+    {{0, 2}, 2, 1, {{0, 1}, {0, 0}}},
+    {{1, -2}, 2, 2, {{0, -1}, {1, -1}}},
+    {{1, -1}, 1, 0, {{0, 0}, {0, 0}}},
+    {{1, 0}, 1, 0, {{0, 0}, {0, 0}}},
+    {{1, 1}, 1, 0, {{0, 0}, {0, 0}}},
+    {{1, 2}, 2, 2, {{0, 1}, {1, 1}}},
+    {{2, -1}, 2, 2, {{1, 0}, {1, -1}}},
+    {{2, 0}, 2, 1, {{1, 0}, {0, 0}}},
+    {{2, 1}, 2, 2, {{1, 0}, {1, 1}}},
+};
+
+// Sets `spot` to the stencil tile, and returns true if it is on the map and
+// the explosion at `centre` reaches it. The occluders are tested as they are
+// now, as los() would have, since an earlier tile of the same explosion may
+// have changed them.
+static bool spellAreaAffectReaches(Coord_t const &centre, AreaAffectTile_t const &tile, Coord_t &spot) {
+    spot.y = centre.y + tile.offset.y;
+    spot.x = centre.x + tile.offset.x;
+
+    if (!coordInBounds(spot)) {
+        return false;
+    }
+
+    for (int i = 0; i < tile.occluder_count; i++) {
+        if (dg.floor.isOpaque(centre.y + tile.occluders[i].y, centre.x + tile.occluders[i].x)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 static void printBoltStrikesMonsterMessage(Creature_t const &creature, const std::string &bolt_name, bool is_lit) {
     std::string monster_name;
     if (is_lit) {
@@ -765,7 +845,7 @@ static void printBoltStrikesMonsterMessage(Creature_t const &creature, const std
 }
 
 // Light up, draw, and check for monster damage when Fire Bolt touches it.
-static void spellFireBoltTouchesMonster(Tile_t &tile, int damage, int harm_type, uint32_t weapon_id, const std::string &bolt_name) {
+static void spellFireBoltTouchesMonster(Tile_t tile, int damage, int harm_type, uint32_t weapon_id, const std::string &bolt_name) {
     Monster_t const &monster = monsters[tile.creature_id];
     Creature_t const &creature = creatures_list[monster.creature_id];
 
@@ -777,7 +857,7 @@ static void spellFireBoltTouchesMonster(Tile_t &tile, int damage, int harm_type,
     tile.permanent_light = saved_lit_status;
 
     // draw monster and clear previous bolt
-    putQIO();
+    panelShowFrame();
 
     printBoltStrikesMonsterMessage(creature, bolt_name, monster.lit);
 
@@ -822,7 +902,7 @@ void spellFireBolt(Coord_t coord, int direction, int damage_hp, int spell_type,
 
         distance++;
 
-        Tile_t &tile = dg.floor[coord.y][coord.x];
+        Tile_t tile = dg.floor[coord.y][coord.x];
 
         dungeonLiteSpot(old_coord);
 
@@ -838,7 +918,7 @@ void spellFireBolt(Coord_t coord, int direction, int damage_hp, int spell_type,
             panelPutTile('*', coord);
 
             // show the bolt
-            putQIO();
+            panelShowFrame();
         }
     }
 }
@@ -847,8 +927,6 @@ void spellFireBolt(Coord_t coord, int direction, int damage_hp, int spell_type,
 void spellFireBall(Coord_t coord, int direction, int damage_hp, int spell_type, const std::string &spell_name) {
     int total_hits = 0;
     int total_kills = 0;
-    int max_distance = 2;
-
     bool (*destroy)(Inventory_t *);
     int harm_type;
     uint32_t weapon_type;
@@ -874,12 +952,12 @@ void spellFireBall(Coord_t coord, int direction, int damage_hp, int spell_type,
             continue;
         }
 
-        Tile_t *tile = &dg.floor[coord.y][coord.x];
+        Tile_t tile = dg.floor[coord.y][coord.x];
 
-        if (tile->feature_id >= MIN_CLOSED_SPACE || tile->creature_id > 1) {
+        if (tile.feature_id >= MIN_CLOSED_SPACE || tile.creature_id > 1) {
             finished = true;
 
-            if (tile->feature_id >= MIN_CLOSED_SPACE) {
+            if (tile.feature_id >= MIN_CLOSED_SPACE) {
                 coord.y = old_coord.y;
                 coord.x = old_coord.x;
             }
@@ -887,68 +965,61 @@ void spellFireBall(Coord_t coord, int direction, int damage_hp, int spell_type,
             // The ball hits and explodes.
 
             // The explosion.
-            for (int row = coord.y - max_distance; row <= coord.y + max_distance; row++) {
-                for (int col = coord.x - max_distance; col <= coord.x + max_distance; col++) {
-                    spot.y = row;
-                    spot.x = col;
+            for (auto const &stencil_tile : area_affect_stencil) {
+                if (spellAreaAffectReaches(coord, stencil_tile, spot)) {
+                    Tile_t spot_tile = dg.floor[spot.y][spot.x];
 
-                    if (coordInBounds(spot) && coordDistanceBetween(coord, spot) <= max_distance && los(coord, spot)) {
-                        tile = &dg.floor[spot.y][spot.x];
+                    if (spot_tile.treasure_id != 0 && (*destroy)(&game.treasure.list[spot_tile.treasure_id])) {
+                        (void) dungeonDeleteObject(spot);
+                    }
 
-                        if (tile->treasure_id != 0 && (*destroy)(&game.treasure.list[tile->treasure_id])) {
-                            (void) dungeonDeleteObject(spot);
-                        }
+                    if (spot_tile.feature_id <= MAX_OPEN_SPACE) {
+                        if (spot_tile.creature_id > 1) {
+                            Monster_t const &monster = monsters[spot_tile.creature_id];
+                            Creature_t const &creature = creatures_list[monster.creature_id];
 
-                        if (tile->feature_id <= MAX_OPEN_SPACE) {
-                            if (tile->creature_id > 1) {
-                                Monster_t const &monster = monsters[tile->creature_id];
-                                Creature_t const &creature = creatures_list[monster.creature_id];
-
-                                // lite up creature if visible, temp set permanent_light so that monsterUpdateVisibility works
-                                bool saved_lit_status = tile->permanent_light;
-                                tile->permanent_light = true;
-                                monsterUpdateVisibility((int) tile->creature_id);
-
-                                total_hits++;
-                                int damage = damage_hp;
-
-                                if ((harm_type & creature.defenses) != 0) {
-                                    damage = damage * 2;
-                                    if (monster.lit) {
-                                        creature_recall[monster.creature_id].defenses |= harm_type;
-                                    }
-                                } else if ((weapon_type & creature.spells) != 0u) {
-                                    damage = damage / 4;
-                                    if (monster.lit) {
-                                        creature_recall[monster.creature_id].spells |= weapon_type;
-                                    }
-                                }
+                            // lite up creature if visible, temp set permanent_light so that monsterUpdateVisibility works
+                            bool saved_lit_status = spot_tile.permanent_light;
+                            spot_tile.permanent_light = true;
+                            monsterUpdateVisibility((int) spot_tile.creature_id);
 
-                                damage = (damage / (coordDistanceBetween(spot, coord) + 1));
+                            total_hits++;
+                            int damage = damage_hp;
 
-                                if (monsterTakeHit((int) tile->creature_id, damage) >= 0) {
-                                    total_kills++;
+                            if ((harm_type & creature.defenses) != 0) {
+                                damage = damage * 2;
+                                if (monster.lit) {
+                                    creature_recall[monster.creature_id].defenses |= harm_type;
+                                }
+                            } else if ((weapon_type & creature.spells) != 0u) {
+                                damage = damage / 4;
+                                if (monster.lit) {
+                                    creature_recall[monster.creature_id].spells |= weapon_type;
                                 }
-                                tile->permanent_light = saved_lit_status;
-                            } else if (coordInsidePanel(spot) && py.flags.blind < 1) {
-                                panelPutTile('*', spot);
                             }
+
+                            damage = (damage / (stencil_tile.distance + 1));
+
+                            if (monsterTakeHit((int) spot_tile.creature_id, damage) >= 0) {
+                                total_kills++;
+                            }
+                            spot_tile.permanent_light = saved_lit_status;
+                        } else if (coordInsidePanel(spot) && py.flags.blind < 1) {
+                            panelPutTile('*', spot);
                         }
                     }
                 }
             }
 
             // show ball of whatever
-            putQIO();
+            panelShowFrame();
 
-            for (int row = (coord.y - 2); row <= (coord.y + 2); row++) {
-                for (int col = (coord.x - 2); col <= (coord.x + 2); col++) {
-                    spot.y = row;
-                    spot.x = col;
+            for (auto const &stencil_tile : area_affect_stencil) {
+                spot.y = coord.y + stencil_tile.offset.y;
+                spot.x = coord.x + stencil_tile.offset.x;
 
-                    if (coordInBounds(spot) && coordInsidePanel(spot) && coordDistanceBetween(coord, spot) <= max_distance) {
-                        dungeonLiteSpot(spot);
-                    }
+                if (coordInBounds(spot) && coordInsidePanel(spot)) {
+                    dungeonLiteSpot(spot);
                 }
             }
             // End explosion.
@@ -973,7 +1044,7 @@ void spellFireBall(Coord_t coord, int direction, int damage_hp, int spell_type,
             panelPutTile('*', coord);
 
             // show bolt
-            putQIO();
+            panelShowFrame();
         }
     }
 }
@@ -981,8 +1052,6 @@ void spellFireBall(Coord_t coord, int direction, int damage_hp, int spell_type,
 // Breath weapon works like a spellFireBall(), but affects the player.
 // Note the area affect. -RAK-
 void spellBreath(Coord_t coord, int monster_id, int damage_hp, int spell_type, const std::string &spell_name) {
-    int max_distance = 2;
-
     bool (*destroy)(Inventory_t *);
     int harm_type;
     uint32_t weapon_type;
@@ -990,92 +1059,90 @@ void spellBreath(Coord_t coord, int monster_id, int damage_hp, int spell_type, c
 
     Coord_t location = Coord_t{0, 0};
 
-    for (location.y = coord.y - 2; location.y <= coord.y + 2; location.y++) {
-        for (location.x = coord.x - 2; location.x <= coord.x + 2; location.x++) {
-            if (coordInBounds(location) && coordDistanceBetween(coord, location) <= max_distance && los(coord, location)) {
-                Tile_t const &tile = dg.floor[location.y][location.x];
-
-                if (tile.treasure_id != 0 && (*destroy)(&game.treasure.list[tile.treasure_id])) {
-                    (void) dungeonDeleteObject(location);
-                }
+    for (auto const &stencil_tile : area_affect_stencil) {
+        if (spellAreaAffectReaches(coord, stencil_tile, location)) {
+            Tile_t const &tile = dg.floor[location.y][location.x];
 
-                if (tile.feature_id <= MAX_OPEN_SPACE) {
-                    // must test status bit, not py.flags.blind here, flag could have
-                    // been set by a previous monster, but the breath should still
-                    // be visible until the blindness takes effect
-                    if (coordInsidePanel(location) && ((py.flags.status & config::player::status::PY_BLIND) == 0u)) {
-                        panelPutTile('*', location);
-                    }
+            if (tile.treasure_id != 0 && (*destroy)(&game.treasure.list[tile.treasure_id])) {
+                (void) dungeonDeleteObject(location);
+            }
 
-                    if (tile.creature_id > 1) {
-                        Monster_t &monster = monsters[tile.creature_id];
-                        Creature_t const &creature = creatures_list[monster.creature_id];
+            if (tile.feature_id <= MAX_OPEN_SPACE) {
+                // must test status bit, not py.flags.blind here, flag could have
+                // been set by a previous monster, but the breath should still
+                // be visible until the blindness takes effect
+                if (coordInsidePanel(location) && ((py.flags.status & config::player::status::PY_BLIND) == 0u)) {
+                    panelPutTile('*', location);
+                }
 
-                        int damage = damage_hp;
+                if (tile.creature_id > 1) {
+                    Monster_t &monster = monsters[tile.creature_id];
+                    Creature_t const &creature = creatures_list[monster.creature_id];
 
-                        if ((harm_type & creature.defenses) != 0) {
-                            damage = damage * 2;
-                        } else if ((weapon_type & creature.spells) != 0u) {
-                            damage = (damage / 4);
-                        }
+                    int damage = damage_hp;
 
-                        damage = (damage / (coordDistanceBetween(location, coord) + 1));
+                    if ((harm_type & creature.defenses) != 0) {
+                        damage = damage * 2;
+                    } else if ((weapon_type & creature.spells) != 0u) {
+                        damage = (damage / 4);
+                    }
 
-                        // can not call monsterTakeHit here, since player does not
-                        // get experience for kill
-                        monster.hp = (int16_t)(monster.hp - damage);
-                        monster.sleep_count = 0;
+                    damage = (damage / (stencil_tile.distance + 1));
 
-                        if (monster.hp < 0) {
-                            uint32_t treasure_id = monsterDeath(Coord_t{monster.pos.y, monster.pos.x}, creature.movement);
+                    // can not call monsterTakeHit here, since player does not
+                    // get experience for kill
+                    monster.hp = (int16_t)(monster.hp - damage);
+                    monster.sleep_count = 0;
 
-                            if (monster.lit) {
-                                auto tmp = (uint32_t)((creature_recall[monster.creature_id].movement & config::monsters::move::CM_TREASURE) >> config::monsters::move::CM_TR_SHIFT);
-                                if (tmp > ((treasure_id & config::monsters::move::CM_TREASURE) >> config::monsters::move::CM_TR_SHIFT)) {
-                                    treasure_id = (uint32_t)((treasure_id & ~config::monsters::move::CM_TREASURE) | (tmp << config::monsters::move::CM_TR_SHIFT));
-                                }
-                                creature_recall[monster.creature_id].movement =
-                                    (uint32_t)(treasure_id | (creature_recall[monster.creature_id].movement & ~config::monsters::move::CM_TREASURE));
-                            }
+                    if (monster.hp < 0) {
+                        uint32_t treasure_id = monsterDeath(Coord_t{monster.pos.y, monster.pos.x}, creature.movement);
 
-                            // It ate an already processed monster. Handle normally.
-                            if (monster_id < tile.creature_id) {
-                                dungeonDeleteMonster((int) tile.creature_id);
-                            } else {
-                                // If it eats this monster, an already processed monster
-                                // will take its place, causing all kinds of havoc.
-                                // Delay the kill a bit.
-                                dungeonRemoveMonsterFromLevel((int) tile.creature_id);
+                        if (monster.lit) {
+                            auto tmp = (uint32_t)((creature_recall[monster.creature_id].movement & config::monsters::move::CM_TREASURE) >> config::monsters::move::CM_TR_SHIFT);
+                            if (tmp > ((treasure_id & config::monsters::move::CM_TREASURE) >> config::monsters::move::CM_TR_SHIFT)) {
+                                treasure_id = (uint32_t)((treasure_id & ~config::monsters::move::CM_TREASURE) | (tmp << config::monsters::move::CM_TR_SHIFT));
                             }
+                            creature_recall[monster.creature_id].movement =
+                                (uint32_t)(treasure_id | (creature_recall[monster.creature_id].movement & ~config::monsters::move::CM_TREASURE));
                         }
-                    } else if (tile.creature_id == 1) {
-                        int damage = (damage_hp / (coordDistanceBetween(location, coord) + 1));
 
-                        // let's do at least one point of damage
-                        // prevents randomNumber(0) problem with damagePoisonedGas, also
-                        if (damage == 0) {
-                            damage = 1;
+                        // It ate an already processed monster. Handle normally.
+                        if (monster_id < tile.creature_id) {
+                            dungeonDeleteMonster((int) tile.creature_id);
+                        } else {
+                            // If it eats this monster, an already processed monster
+                            // will take its place, causing all kinds of havoc.
+                            // Delay the kill a bit.
+                            dungeonRemoveMonsterFromLevel((int) tile.creature_id);
                         }
+                    }
+                } else if (tile.creature_id == 1) {
+                    int damage = (damage_hp / (stencil_tile.distance + 1));
 
-                        switch (spell_type) {
-                            case MagicSpellFlags::Lightning:
-                                damageLightningBolt(damage, spell_name.c_str());
-                                break;
-                            case MagicSpellFlags::PoisonGas:
-                                damagePoisonedGas(damage, spell_name.c_str());
-                                break;
-                            case MagicSpellFlags::Acid:
-                                damageAcid(damage, spell_name.c_str());
-                                break;
-                            case MagicSpellFlags::Frost:
-                                damageCold(damage, spell_name.c_str());
-                                break;
-                            case MagicSpellFlags::Fire:
-                                damageFire(damage, spell_name.c_str());
-                                break;
-                            default:
-                                break;
-                        }
+                    // let's do at least one point of damage
+                    // prevents randomNumber(0) problem with damagePoisonedGas, also
+                    if (damage == 0) {
+                        damage = 1;
+                    }
+
+                    switch (spell_type) {
+                        case MagicSpellFlags::Lightning:
+                            damageLightningBolt(damage, spell_name.c_str());
+                            break;
+                        case MagicSpellFlags::PoisonGas:
+                            damagePoisonedGas(damage, spell_name.c_str());
+                            break;
+                        case MagicSpellFlags::Acid:
+                            damageAcid(damage, spell_name.c_str());
+                            break;
+                        case MagicSpellFlags::Frost:
+                            damageCold(damage, spell_name.c_str());
+                            break;
+                        case MagicSpellFlags::Fire:
+                            damageFire(damage, spell_name.c_str());
+                            break;
+                        default:
+                            break;
                     }
                 }
             }
@@ -1083,14 +1150,14 @@ void spellBreath(Coord_t coord, int monster_id, int damage_hp, int spell_type, c
     }
 
     // show the ball of gas
-    putQIO();
+    panelShowFrame();
 
-    Coord_t spot = Coord_t{0, 0};
-    for (spot.y = (coord.y - 2); spot.y <= (coord.y + 2); spot.y++) {
-        for (spot.x = (coord.x - 2); spot.x <= (coord.x + 2); spot.x++) {
-            if (coordInBounds(spot) && coordInsidePanel(spot) && coordDistanceBetween(coord, spot) <= max_distance) {
-                dungeonLiteSpot(spot);
-            }
+    for (auto const &stencil_tile : area_affect_stencil) {
+        location.y = coord.y + stencil_tile.offset.y;
+        location.x = coord.x + stencil_tile.offset.x;
+
+        if (coordInBounds(location) && coordInsidePanel(location)) {
+            dungeonLiteSpot(location);
         }
     }
 }
@@ -1253,6 +1320,7 @@ bool spellSpeedMonster(Coord_t coord, int direction, int speed) {
             if (speed > 0) {
                 monster.speed += speed;
                 monster.sleep_count = 0;
+                monsterScheduleSpeedChanged(tile.creature_id);
 
                 changed = true;
 
@@ -1260,6 +1328,7 @@ bool spellSpeedMonster(Coord_t coord, int direction, int speed) {
             } else if (randomNumber(MON_MAX_LEVELS) > creature.level) {
                 monster.speed += speed;
                 monster.sleep_count = 0;
+                monsterScheduleSpeedChanged(tile.creature_id);
 
                 changed = true;
 
@@ -1458,17 +1527,15 @@ bool spellDestroyDoorsTrapsInDirection(Coord_t coord, int direction) {
     bool destroyed = false;
     int distance = 0;
 
-    Tile_t *tile = nullptr;
-
     do {
         (void) playerMovePosition(direction, coord);
         distance++;
 
-        tile = &dg.floor[coord.y][coord.x];
+        Tile_t const &tile = dg.floor[coord.y][coord.x];
 
         // must move into first closed spot, as it might be a secret door
-        if (tile->treasure_id != 0) {
-            Inventory_t &item = game.treasure.list[tile->treasure_id];
+        if (tile.treasure_id != 0) {
+            Inventory_t &item = game.treasure.list[tile.treasure_id];
 
             if (item.category_id == TV_INVIS_TRAP || item.category_id == TV_CLOSED_DOOR || item.category_id == TV_VIS_TRAP || item.category_id == TV_OPEN_DOOR ||
                 item.category_id == TV_SECRET_DOOR) {
@@ -1486,7 +1553,7 @@ bool spellDestroyDoorsTrapsInDirection(Coord_t coord, int direction) {
                 spellItemIdentifyAndRemoveRandomInscription(item);
             }
         }
-    } while ((distance <= config::treasure::OBJECT_BOLTS_MAX_RANGE) || tile->feature_id <= MAX_OPEN_SPACE);
+    } while ((distance <= config::treasure::OBJECT_BOLTS_MAX_RANGE) || dg.floor[coord.y][coord.x].feature_id <= MAX_OPEN_SPACE);
 
     return destroyed;
 }
@@ -1545,7 +1612,7 @@ bool spellBuildWall(Coord_t coord, int direction) {
         (void) playerMovePosition(direction, coord);
         distance++;
 
-        Tile_t &tile = dg.floor[coord.y][coord.x];
+        Tile_t tile = dg.floor[coord.y][coord.x];
 
         if (distance > config::treasure::OBJECT_BOLTS_MAX_RANGE || tile.feature_id >= MIN_CLOSED_SPACE) {
             finished = true;
@@ -1726,12 +1793,25 @@ bool spellTeleportAwayMonsterInDirection(Coord_t coord, int direction) {
     return teleported;
 }
 
+// Collects the ids of the monsters close enough to the player to be
+// within MON_MAX_SIGHT, highest id first. Callers still test the
+// monsters `distance_from_player`, this only narrows down who to check.
+static int spellMonstersWithinSight(int16_t *ids) {
+    int sight = config::monsters::MON_MAX_SIGHT;
+
+    return monsterIndexQuery(Coord_t{py.pos.y - sight, py.pos.x - sight}, Coord_t{py.pos.y + sight, py.pos.x + sight}, ids);
+}
+
 // Delete all creatures within max_sight distance -RAK-
 // NOTE : Winning creatures cannot be killed by genocide.
 bool spellMassGenocide() {
     bool killed = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+    int16_t ids[MON_TOTAL_ALLOCATIONS];
+    int count = spellMonstersWithinSight(ids);
+
+    for (int i = 0; i < count; i++) {
+        int id = ids[i];
         Monster_t const &monster = monsters[id];
         Creature_t const &creature = creatures_list[monster.creature_id];
 
@@ -1756,6 +1836,10 @@ bool spellGenocide() {
     bool killed = false;
 
     for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+        if (!monsterIsAllocated(id)) {
+            continue;
+        }
+
         Monster_t const &monster = monsters[id];
         Creature_t const &creature = creatures_list[monster.creature_id];
 
@@ -1780,19 +1864,24 @@ bool spellGenocide() {
 bool spellSpeedAllMonsters(int speed) {
     bool speedy = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+    int16_t ids[MON_TOTAL_ALLOCATIONS];
+    int count = spellMonstersWithinSight(ids);
+
+    for (int i = 0; i < count; i++) {
+        int id = ids[i];
         Monster_t &monster = monsters[id];
         Creature_t const &creature = creatures_list[monster.creature_id];
 
         auto name = monsterNameDescription(creature.name, monster.lit);
 
-        if (monster.distance_from_player > config::monsters::MON_MAX_SIGHT || !los(py.pos, monster.pos)) {
+        if (monster.distance_from_player > config::monsters::MON_MAX_SIGHT || !losFromPlayer(monster.pos)) {
             continue; // do nothing
         }
 
         if (speed > 0) {
             monster.speed += speed;
             monster.sleep_count = 0;
+            monsterScheduleSpeedChanged(id);
 
             if (monster.lit) {
                 speedy = true;
@@ -1801,6 +1890,7 @@ bool spellSpeedAllMonsters(int speed) {
         } else if (randomNumber(MON_MAX_LEVELS) > creature.level) {
             monster.speed += speed;
             monster.sleep_count = 0;
+            monsterScheduleSpeedChanged(id);
 
             if (monster.lit) {
                 speedy = true;
@@ -1819,13 +1909,17 @@ bool spellSpeedAllMonsters(int speed) {
 bool spellSleepAllMonsters() {
     bool asleep = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+    int16_t ids[MON_TOTAL_ALLOCATIONS];
+    int count = spellMonstersWithinSight(ids);
+
+    for (int i = 0; i < count; i++) {
+        int id = ids[i];
         Monster_t &monster = monsters[id];
         Creature_t const &creature = creatures_list[monster.creature_id];
 
         auto name = monsterNameDescription(creature.name, monster.lit);
 
-        if (monster.distance_from_player > config::monsters::MON_MAX_SIGHT || !los(py.pos, monster.pos)) {
+        if (monster.distance_from_player > config::monsters::MON_MAX_SIGHT || !losFromPlayer(monster.pos)) {
             continue; // do nothing
         }
 
@@ -1854,7 +1948,11 @@ bool spellMassPolymorph() {
     bool morphed = false;
     Coord_t coord = Coord_t{0, 0};
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+    int16_t ids[MON_TOTAL_ALLOCATIONS];
+    int count = spellMonstersWithinSight(ids);
+
+    for (int i = 0; i < count; i++) {
+        int id = ids[i];
         Monster_t const &monster = monsters[id];
 
         if (monster.distance_from_player <= config::monsters::MON_MAX_SIGHT) {
@@ -1878,11 +1976,15 @@ bool spellMassPolymorph() {
 bool spellDetectEvil() {
     bool detected = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
-        Monster_t &monster = monsters[id];
+    int16_t ids[MON_TOTAL_ALLOCATIONS];
+    int count = monsterIndexQuery(Coord_t{dg.panel.top, dg.panel.left}, Coord_t{dg.panel.bottom, dg.panel.right}, ids);
+
+    for (int i = 0; i < count; i++) {
+        Monster_t &monster = monsters[ids[i]];
 
-        if (coordInsidePanel(Coord_t{monster.pos.y, monster.pos.x}) && ((creatures_list[monster.creature_id].defenses & config::monsters::defense::CD_EVIL) != 0)) {
+        if ((creatures_list[monster.creature_id].defenses & config::monsters::defense::CD_EVIL) != 0) {
             monster.lit = true;
+            monsterScheduleWake(ids[i]);
 
             detected = true;
 
@@ -1971,7 +2073,7 @@ void spellEarthquake() {
     for (coord.y = py.pos.y - 8; coord.y <= py.pos.y + 8; coord.y++) {
         for (coord.x = py.pos.x - 8; coord.x <= py.pos.x + 8; coord.x++) {
             if ((coord.y != py.pos.y || coord.x != py.pos.x) && coordInBounds(coord) && randomNumber(8) == 1) {
-                Tile_t &tile = dg.floor[coord.y][coord.x];
+                Tile_t tile = dg.floor[coord.y][coord.x];
 
                 if (tile.treasure_id != 0) {
                     (void) dungeonDeleteObject(coord);
@@ -2029,11 +2131,15 @@ void spellCreateFood() {
 bool spellDispelCreature(int creature_defense, int damage) {
     bool dispelled = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+    int16_t ids[MON_TOTAL_ALLOCATIONS];
+    int count = spellMonstersWithinSight(ids);
+
+    for (int i = 0; i < count; i++) {
+        int id = ids[i];
         Monster_t const &monster = monsters[id];
 
         if (monster.distance_from_player <= config::monsters::MON_MAX_SIGHT && ((creature_defense & creatures_list[monster.creature_id].defenses) != 0) &&
-            los(py.pos, monster.pos)) {
+            losFromPlayer(monster.pos)) {
             Creature_t const &creature = creatures_list[monster.creature_id];
 
             creature_recall[monster.creature_id].defenses |= creature_defense;
@@ -2064,11 +2170,15 @@ bool spellDispelCreature(int creature_defense, int damage) {
 bool spellTurnUndead() {
     bool turned = false;
 
-    for (int id = next_free_monster_id - 1; id >= config::monsters::MON_MIN_INDEX_ID; id--) {
+    int16_t ids[MON_TOTAL_ALLOCATIONS];
+    int count = spellMonstersWithinSight(ids);
+
+    for (int i = 0; i < count; i++) {
+        int id = ids[i];
         Monster_t &monster = monsters[id];
         Creature_t const &creature = creatures_list[monster.creature_id];
 
-        if (monster.distance_from_player <= config::monsters::MON_MAX_SIGHT && ((creature.defenses & config::monsters::defense::CD_UNDEAD) != 0) && los(py.pos, monster.pos)) {
+        if (monster.distance_from_player <= config::monsters::MON_MAX_SIGHT && ((creature.defenses & config::monsters::defense::CD_UNDEAD) != 0) && losFromPlayer(monster.pos)) {
             auto name = monsterNameDescription(creature.name, monster.lit);
 
             if (py.misc.level + 1 > creature.level || randomNumber(5) == 1) {
@@ -2210,7 +2320,7 @@ bool spellSlowPoison() {
 }
 
 static void replaceSpot(Coord_t coord, int typ) {
-    Tile_t &tile = dg.floor[coord.y][coord.x];
+    Tile_t tile = dg.floor[coord.y][coord.x];
 
     switch (typ) {
         case 1:
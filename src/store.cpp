@@ -18,6 +18,8 @@ static void storeUpdateBargainingSkills(Store_t &store, int32_t price, int32_t m
 
 // Initializes the stores with owners -RAK-
 void storeInitializeOwners() {
+    RngStreamScope_t rng_scope(rng_streams.stores);
+
     int count = MAX_OWNERS / MAX_STORES;
 
     for (int store_id = 0; store_id < MAX_STORES; store_id++) {
@@ -1098,6 +1100,8 @@ static bool storeSellAnItem(int store_id, int &current_top_item_id) {
 
 // Entering a store -RAK-
 void storeEnter(int store_id) {
+    RngStreamScope_t rng_scope(rng_streams.stores);
+
     Store_t const &store = stores[store_id];
 
     if (store.turns_left_before_closing >= dg.game_turn) {
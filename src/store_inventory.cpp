@@ -25,6 +25,9 @@ static int32_t getPickShovelBuyPrice(Inventory_t const &item);
 
 // Initialize and up-keep the store's inventory. -RAK-
 void storeMaintenance() {
+    TURN_STATS_PHASE(TurnPhase::Stores);
+    RngStreamScope_t rng_scope(rng_streams.stores);
+
     for (int store_id = 0; store_id < MAX_STORES; store_id++) {
         Store_t &store = stores[store_id];
 
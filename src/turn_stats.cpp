@@ -0,0 +1,258 @@
+// Copyright (c) 1981-86 Robert A. Koeneke
+// Copyright (c) 1987-94 James E. Wilson
+//
+// This work is free software released under the GNU General Public License
+// version 2.0, and comes with ABSOLUTELY NO WARRANTY.
+//
+// See LICENSE and AUTHORS for more information.
+
+// Per turn timings of the game loop phases, for finding slow turns
+
+#include "headers.h"
+
+#ifdef UMORIA_TURN_STATS
+
+#include <chrono>
+
+typedef struct {
+    const char *title; // as shown on the stats screen
+    const char *name;  // as used for the columns of the stats file
+} TurnStatsName_t;
+
+static TurnStatsName_t const phase_names[TURN_PHASES] = {
+    {"Other", "other_ns"},
+    {"Status updates", "status_ns"},
+    {"Commands", "commands_ns"},
+    {"Key waits", "key_wait_ns"},
+    {"Monsters", "monsters_ns"},
+    {"Compact monsters", "compact_ns"},
+    {"Store maintenance", "stores_ns"},
+    {"Level generation", "level_ns"},
+    {"Drawing", "drawing_ns"},
+};
+
+static TurnStatsName_t const counter_names[TURN_COUNTERS] = {
+    {"los() calls", "los_calls"},
+    {"Monsters processed", "monsters_processed"},
+    {"Curses writes", "curses_writes"},
+};
+
+// The turn being played, which is added to `turns_kept` once it is over.
+// Turns before the game starts are numbered -1, and are not kept.
+TurnStats_t turn_stats = TurnStats_t{-1, {}, {}};
+
+static TurnStats_t turns_kept[TURN_STATS_KEPT];
+static int turns_kept_next = 0;
+static int turns_kept_total = 0;
+
+static TurnPhase phase_in_progress = TurnPhase::Other;
+static uint64_t phase_started_at = 0;
+
+static uint64_t turnStatsNow() {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Puts the time since the phase in progress was last timed down to it.
+static void turnStatsTimePhase() {
+    uint64_t now = turnStatsNow();
+    if (phase_started_at != 0) {
+        turn_stats.phase_ns[(int) phase_in_progress] += now - phase_started_at;
+    }
+    phase_started_at = now;
+}
+
+TurnPhase turnStatsEnterPhase(TurnPhase phase) {
+    turnStatsTimePhase();
+
+    TurnPhase outer = phase_in_progress;
+    phase_in_progress = phase;
+
+    return outer;
+}
+
+void turnStatsLeavePhase(TurnPhase outer) {
+    turnStatsTimePhase();
+
+    phase_in_progress = outer;
+}
+
+// Keeps the turn just over, and starts on `game_turn`.
+void turnStatsBeginTurn(int32_t game_turn) {
+    turnStatsTimePhase();
+
+    if (turn_stats.game_turn >= 0) {
+        turns_kept[turns_kept_next] = turn_stats;
+        turns_kept_next = (turns_kept_next + 1) % TURN_STATS_KEPT;
+        if (turns_kept_total < TURN_STATS_KEPT) {
+            turns_kept_total++;
+        }
+    }
+
+    turn_stats = TurnStats_t{game_turn, {}, {}};
+}
+
+// The kept turns, oldest first.
+static TurnStats_t const &turnStatsKept(int index) {
+    return turns_kept[(turns_kept_next - turns_kept_total + index + TURN_STATS_KEPT) % TURN_STATS_KEPT];
+}
+
+// The time a turn took, not counting the time spent waiting for keys.
+static uint64_t turnStatsBusyTime(TurnStats_t const &turn) {
+    uint64_t busy = 0;
+    for (int phase = 0; phase < TURN_PHASES; phase++) {
+        if (phase != (int) TurnPhase::KeyWait) {
+            busy += turn.phase_ns[phase];
+        }
+    }
+    return busy;
+}
+
+static std::string turnStatsFormatTime(uint64_t ns) {
+    char text[32];
+
+    if (ns < 1000000) {
+        (void) sprintf(text, "%.1f us", (double) ns / 1e3);
+    } else {
+        (void) sprintf(text, "%.2f ms", (double) ns / 1e6);
+    }
+
+    return text;
+}
+
+void turnStatsDisplay() {
+    terminalSaveScreen();
+    clearScreen();
+
+    if (turns_kept_total == 0) {
+        putStringClearToEOL("No turns have been played yet.", Coord_t{0, 0});
+        waitForContinueKey(2);
+        terminalRestoreScreen();
+        return;
+    }
+
+    char line[160] = {'\0'};
+
+    (void) sprintf(line, "Timings of the last %d turns, turns %d to %d:", turns_kept_total, (int) turnStatsKept(0).game_turn, (int) turnStatsKept(turns_kept_total - 1).game_turn);
+    putString(line, Coord_t{0, 0});
+
+    (void) sprintf(line, "%-20s %14s %14s %8s", "Phase", "Mean per turn", "Slowest", "On turn");
+    putString(line, Coord_t{2, 2});
+
+    for (int phase = 0; phase < TURN_PHASES; phase++) {
+        uint64_t total = 0;
+        uint64_t slowest = 0;
+        int32_t slowest_turn = 0;
+
+        for (int i = 0; i < turns_kept_total; i++) {
+            TurnStats_t const &turn = turnStatsKept(i);
+            total += turn.phase_ns[phase];
+            if (turn.phase_ns[phase] > slowest) {
+                slowest = turn.phase_ns[phase];
+                slowest_turn = turn.game_turn;
+            }
+        }
+
+        (void) sprintf(line, "%-20s %14s %14s %8d", phase_names[phase].title, turnStatsFormatTime(total / (uint64_t) turns_kept_total).c_str(), turnStatsFormatTime(slowest).c_str(), (int) slowest_turn);
+        putString(line, Coord_t{3 + phase, 2});
+    }
+
+    int row = 4 + TURN_PHASES;
+
+    (void) sprintf(line, "%-20s %14s %14s %8s", "Count", "Mean per turn", "Most", "On turn");
+    putString(line, Coord_t{row, 2});
+
+    for (int counter = 0; counter < TURN_COUNTERS; counter++) {
+        uint64_t total = 0;
+        uint32_t most = 0;
+        int32_t most_turn = 0;
+
+        for (int i = 0; i < turns_kept_total; i++) {
+            TurnStats_t const &turn = turnStatsKept(i);
+            total += turn.counters[counter];
+            if (turn.counters[counter] > most) {
+                most = turn.counters[counter];
+                most_turn = turn.game_turn;
+            }
+        }
+
+        (void) sprintf(line, "%-20s %14.1f %14u %8d", counter_names[counter].title, (double) total / turns_kept_total, most, (int) most_turn);
+        putString(line, Coord_t{row + 1 + counter, 2});
+    }
+
+    row += 2 + TURN_COUNTERS;
+
+    int slowest = 0;
+    for (int i = 1; i < turns_kept_total; i++) {
+        if (turnStatsBusyTime(turnStatsKept(i)) > turnStatsBusyTime(turnStatsKept(slowest))) {
+            slowest = i;
+        }
+    }
+    TurnStats_t const &slowest_turn = turnStatsKept(slowest);
+
+    (void) sprintf(line, "The slowest turn was turn %d, taking %s (not counting key waits).", (int) slowest_turn.game_turn, turnStatsFormatTime(turnStatsBusyTime(slowest_turn)).c_str());
+    putString(line, Coord_t{row, 0});
+
+    putStringClearToEOL("[ w to write the turns to a file, any other key to continue ]", Coord_t{row + 2, 9});
+
+    if (getKeyInput() == 'w') {
+        putStringClearToEOL("File name: ", Coord_t{0, 0});
+
+        vtype_t filename = {'\0'};
+        if (getStringInput(filename, Coord_t{0, 11}, 64) && strlen(filename) > 0) {
+            if (turnStatsWriteToFile(filename)) {
+                putStringClearToEOL("Done.", Coord_t{0, 0});
+            } else {
+                putStringClearToEOL("File could not be written.", Coord_t{0, 0});
+            }
+            waitForContinueKey(row + 2);
+        }
+    }
+
+    terminalRestoreScreen();
+}
+
+// Writes the kept turns to `filename` as tab separated columns, with
+// a heading line giving the names of the columns.
+bool turnStatsWriteToFile(const std::string &filename) {
+    FILE *file = fopen(filename.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+
+    (void) fprintf(file, "turn");
+    for (auto const &phase : phase_names) {
+        (void) fprintf(file, "\t%s", phase.name);
+    }
+    for (auto const &counter : counter_names) {
+        (void) fprintf(file, "\t%s", counter.name);
+    }
+    (void) fprintf(file, "\n");
+
+    for (int i = 0; i < turns_kept_total; i++) {
+        TurnStats_t const &turn = turnStatsKept(i);
+
+        (void) fprintf(file, "%d", (int) turn.game_turn);
+        for (auto phase_ns : turn.phase_ns) {
+            (void) fprintf(file, "\t%llu", (unsigned long long) phase_ns);
+        }
+        for (auto count : turn.counters) {
+            (void) fprintf(file, "\t%u", count);
+        }
+        (void) fprintf(file, "\n");
+    }
+
+    return fclose(file) == 0;
+}
+
+#else
+
+void turnStatsDisplay() {
+    printMessage("This game was built without turn stats.");
+}
+
+bool turnStatsWriteToFile(const std::string &filename) {
+    (void) filename;
+    return false;
+}
+
+#endif
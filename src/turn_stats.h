@@ -0,0 +1,81 @@
+// Copyright (c) 1981-86 Robert A. Koeneke
+// Copyright (c) 1987-94 James E. Wilson
+//
+// This work is free software released under the GNU General Public License
+// version 2.0, and comes with ABSOLUTELY NO WARRANTY.
+//
+// See LICENSE and AUTHORS for more information.
+
+#pragma once
+
+// Timings of the phases of each game turn, and counts of the busiest
+// operations, kept for the last TURN_STATS_KEPT turns. They are only
+// collected when built with UMORIA_TURN_STATS, otherwise the macros
+// below compile to nothing.
+
+// Time spent outside of all other phases is put down to `Other`.
+enum class TurnPhase {
+    Other,
+    Status,   // player status updates at the start of a turn
+    Commands, // executing the player's commands
+    KeyWait,  // waiting for a key press
+    Monsters, // updateMonsters()
+    Compact,  // compactMonsters()
+    Stores,   // storeMaintenance()
+    Level,    // generateCave()
+    Drawing,  // writing the screen out to the terminal
+};
+constexpr int TURN_PHASES = 9;
+
+enum class TurnCounter {
+    LosCalls,
+    MonstersProcessed,
+    CursesWrites,
+};
+constexpr int TURN_COUNTERS = 3;
+
+constexpr int TURN_STATS_KEPT = 1024;
+
+#ifdef UMORIA_TURN_STATS
+
+typedef struct {
+    int32_t game_turn;
+    uint64_t phase_ns[TURN_PHASES];
+    uint32_t counters[TURN_COUNTERS];
+} TurnStats_t;
+
+extern TurnStats_t turn_stats;
+
+TurnPhase turnStatsEnterPhase(TurnPhase phase);
+void turnStatsLeavePhase(TurnPhase outer);
+void turnStatsBeginTurn(int32_t game_turn);
+
+// Times the enclosing scope as `phase`. A phase started within another
+// phase is taken out of the outer phase's time.
+class TurnPhaseTimer_t {
+public:
+    explicit TurnPhaseTimer_t(TurnPhase phase) : outer(turnStatsEnterPhase(phase)) {}
+    ~TurnPhaseTimer_t() { turnStatsLeavePhase(outer); }
+
+    TurnPhaseTimer_t(TurnPhaseTimer_t const &) = delete;
+    TurnPhaseTimer_t &operator=(TurnPhaseTimer_t const &) = delete;
+
+private:
+    TurnPhase outer;
+};
+
+#define TURN_STATS_PHASE(phase) TurnPhaseTimer_t turn_phase_timer(phase)
+#define TURN_STATS_COUNT(counter) (turn_stats.counters[(int) (counter)]++)
+#define TURN_STATS_BEGIN_TURN(game_turn) turnStatsBeginTurn(game_turn)
+
+#else
+
+#define TURN_STATS_PHASE(phase)
+#define TURN_STATS_COUNT(counter)
+#define TURN_STATS_BEGIN_TURN(game_turn)
+
+#endif
+
+// turn_stats.cpp, these are there in every build
+void turnStatsDisplay();
+bool turnStatsWriteToFile(const std::string &filename);
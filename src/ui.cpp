@@ -17,9 +17,7 @@ static char blank_string[] = "                        ";
 // Track screen changes for inventory commands
 bool screen_has_changed = false;
 
-bool message_ready_to_print;            // Set with first message
-vtype_t messages[MESSAGE_HISTORY_SIZE]; // Saved message history -CJS-
-int16_t last_message_id = 0;            // Index of last message held in saved messages array
+bool message_ready_to_print; // Set with first message
 
 // Calculates current boundaries -RAK-
 static void panelBounds() {
@@ -82,22 +80,16 @@ bool coordInsidePanel(Coord_t coord) {
 }
 
 // Prints the map of the dungeon -RAK-
+// Blank tiles are drawn too, so that only the tiles that
+// have changed since the last draw get sent to the terminal.
 void drawDungeonPanel() {
-    int line = 1;
-
     Coord_t coord = Coord_t{0, 0};
 
     // Top to bottom
     for (coord.y = dg.panel.top; coord.y <= dg.panel.bottom; coord.y++) {
-        eraseLine(Coord_t{line, 13});
-        line++;
-
         // Left to right
         for (coord.x = dg.panel.left; coord.x <= dg.panel.right; coord.x++) {
-            char ch = caveGetTileSymbol(coord);
-            if (ch != ' ') {
-                panelPutTile(ch, coord);
-            }
+            panelPutTile(caveGetTileSymbol(coord), coord);
         }
     }
 }
@@ -730,9 +722,7 @@ void displaySpellsList(const int *spell_ids, int number_of_choices, bool comment
 static void playerGainLevel() {
     py.misc.level++;
 
-    vtype_t msg = {'\0'};
-    (void) sprintf(msg, "Welcome to level %d.", (int) py.misc.level);
-    printMessage(msg);
+    printMessageFormat(MessageSource::Character, "Welcome to level %d.", py.misc.level);
 
     playerCalculateHitPoints();
 
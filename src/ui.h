@@ -32,6 +32,10 @@ constexpr uint8_t MSG_LINE = 0;
 // How many messages to save in the buffer -CJS-
 constexpr uint8_t MESSAGE_HISTORY_SIZE = 22;
 
+// How often (in game turns) to poll for a key press that interrupts
+// resting or a repeated command. Running polls on every turn.
+constexpr uint8_t KEY_PRESS_POLL_TURNS = 8;
+
 // Column for stats
 constexpr uint8_t STAT_COLUMN = 0;
 
@@ -47,18 +51,33 @@ constexpr char ESCAPE = '\033'; // ESCAPE character -CJS-
 
 extern bool screen_has_changed;
 extern bool message_ready_to_print;
-extern vtype_t messages[MESSAGE_HISTORY_SIZE];
-extern int16_t last_message_id;
 
 extern int eof_flag;
 extern bool panic_save;
 
+// KeySource_t is where the game reads its key presses from: the terminal,
+// a batch command script or a replay.
+typedef struct {
+    int (*readKey)();          // Next key press, EOF at the end of input
+    bool (*keyPressWaiting)(); // Was a key pressed while the game was busy, the key is consumed
+    bool is_script;            // Keys written without seeing the screen, they don't answer -more- prompts
+} KeySource_t;
+
+// Returned by readKey() of a key source which has handed over to another
+// source, the key press is then read from that one instead.
+constexpr int KEY_SOURCE_CHANGED = -2;
+
 // UI - IO
 bool terminalInitialize();
+bool terminalInitializeBatchMode(const std::string &script_file);
+void terminalInitializeNullUI(KeySource_t const &source);
+bool terminalLeaveNullUI();
+void terminalDetach();
 void terminalRestore();
 void terminalSaveScreen();
 void terminalRestoreScreen();
 ssize_t terminalBellSound();
+void panelShowFrame();
 void putQIO();
 void flushInputBuffer();
 void clearScreen();
@@ -79,7 +98,7 @@ bool getCommand(const std::string &prompt, char &command);
 bool getStringInput(char *in_str, Coord_t coord, int slen);
 bool getInputConfirmation(const std::string &prompt);
 void waitForContinueKey(int line_number);
-bool checkForNonBlockingKeyPress(int microseconds);
+bool checkForNonBlockingKeyPress();
 void getDefaultPlayerName(char *buffer);
 bool checkFilePermissions();
 
@@ -14,12 +14,143 @@
 
 static bool curses_on = false;
 
+// Batch mode runs the game without a terminal, the null UI: all screen
+// output is discarded and key presses are read from a command script (-b
+// option) or a replay (--replay option).
+static bool batch_mode = false;
+static FILE *batch_input = nullptr;
+
+static int terminalReadKey();
+static bool terminalKeyPressWaiting();
+static int batchReadKey();
+static bool batchKeyPressWaiting();
+static int detachedReadKey();
+
+static const KeySource_t terminal_key_source = {terminalReadKey, terminalKeyPressWaiting, false};
+static const KeySource_t batch_key_source = {batchReadKey, batchKeyPressWaiting, true};
+static const KeySource_t detached_key_source = {detachedReadKey, batchKeyPressWaiting, true};
+
+// Where all key presses are read from.
+static KeySource_t const *key_source = &terminal_key_source;
+
 // Spare window for saving the screen. -CJS-
 static WINDOW *save_screen;
 
 int eof_flag = 0;        // Is used to signal EOF/HANGUP condition
 bool panic_save = false; // True if playing from a panic save
 
+// Screen location of the top left corner of the dungeon panel
+constexpr int PANEL_SCREEN_ROW = 1;
+constexpr int PANEL_SCREEN_COL = 13;
+
+// Back-buffer for the dungeon panel. panelPutTile() only records the new
+// glyph and marks the cell as dirty, the dirty cells are then sent to curses
+// in one pass by panelFlushTiles(), skipping any whose glyph is unchanged.
+//
+// `panel_glyphs` holds the glyphs last drawn on the screen, with a `0` when
+// the cell has been overwritten by something else, such as an inventory list.
+static char panel_glyphs[SCREEN_HEIGHT][SCREEN_WIDTH];
+static char panel_saved_glyphs[SCREEN_HEIGHT][SCREEN_WIDTH];
+static char panel_pending[SCREEN_HEIGHT][SCREEN_WIDTH];
+static bool panel_dirty[SCREEN_HEIGHT][SCREEN_WIDTH];
+static bool panel_row_dirty[SCREEN_HEIGHT];
+static bool panel_has_dirty_tiles = false;
+
+// Frames of a bolt, ball or thrown object in flight. panelShowFrame() takes
+// the tiles changed since the last frame off the dirty cells into a queue,
+// which the next panelFlushTiles() plays out before anything else is drawn,
+// one screen refresh per frame, PANEL_FRAME_MS apart.
+typedef struct {
+    uint8_t row;
+    uint8_t col;
+    char glyph;
+} PanelFrameTile_t;
+
+constexpr int PANEL_FRAME_MS = 15;
+constexpr int PANEL_FRAMES_MAX = 64;
+constexpr int PANEL_FRAME_TILES_MAX = 512;
+
+static PanelFrameTile_t panel_frame_tiles[PANEL_FRAME_TILES_MAX];
+static int panel_frame_ends[PANEL_FRAMES_MAX]; // one past the last tile of each frame
+static int panel_frames = 0;
+
+// Draw `ch` in the panel cell, unless it is already on the screen.
+static void panelDrawTile(int row, int col, char ch) {
+    if (ch == panel_glyphs[row][col]) {
+        return;
+    }
+    panel_glyphs[row][col] = ch;
+
+    TURN_STATS_COUNT(TurnCounter::CursesWrites);
+    if (mvaddch(row + PANEL_SCREEN_ROW, col + PANEL_SCREEN_COL, ch) == ERR) {
+        abort();
+    }
+}
+
+static void panelPlayFrames() {
+    int tile = 0;
+
+    for (int frame = 0; frame < panel_frames; frame++) {
+        for (; tile < panel_frame_ends[frame]; tile++) {
+            panelDrawTile(panel_frame_tiles[tile].row, panel_frame_tiles[tile].col, panel_frame_tiles[tile].glyph);
+        }
+
+        (void) refresh();
+        (void) napms(PANEL_FRAME_MS);
+    }
+
+    panel_frames = 0;
+}
+
+// Send all changed dungeon panel tiles to curses -- the cursor position is maintained.
+static void panelFlushTiles() {
+    if (panel_frames == 0 && !panel_has_dirty_tiles) {
+        return;
+    }
+
+    int y, x;
+    getyx(stdscr, y, x);
+
+    if (panel_frames > 0) {
+        panelPlayFrames();
+    }
+
+    if (panel_has_dirty_tiles) {
+        panel_has_dirty_tiles = false;
+
+        for (int row = 0; row < SCREEN_HEIGHT; row++) {
+            if (!panel_row_dirty[row]) {
+                continue;
+            }
+            panel_row_dirty[row] = false;
+
+            for (int col = 0; col < SCREEN_WIDTH; col++) {
+                if (panel_dirty[row][col]) {
+                    panel_dirty[row][col] = false;
+                    panelDrawTile(row, col, panel_pending[row][col]);
+                }
+            }
+        }
+    }
+
+    (void) move(y, x);
+}
+
+// Record screen cells written to directly, rather than through panelPutTile().
+// A `glyph` value of `0` marks the cells as unknown.
+static void panelSetScreenCells(Coord_t coord, int length, char glyph) {
+    int row = coord.y - PANEL_SCREEN_ROW;
+    if (row < 0 || row >= SCREEN_HEIGHT) {
+        return;
+    }
+
+    for (int col = coord.x - PANEL_SCREEN_COL; col < coord.x - PANEL_SCREEN_COL + length; col++) {
+        if (col >= 0 && col < SCREEN_WIDTH) {
+            panel_glyphs[row][col] = glyph;
+        }
+    }
+}
+
 // Set up the terminal into a suitable state -MRC-
 static void moriaTerminalInitialize() {
     // cbreak();           // <curses.h> use raw() instead as it disables Ctrl chars
@@ -60,6 +191,55 @@ bool terminalInitialize() {
     return true;
 }
 
+// Initialize the null terminal used by batch mode. Keys are read from
+// `script_file`, or from stdin when the filename is "-".
+bool terminalInitializeBatchMode(const std::string &script_file) {
+    if (script_file == "-") {
+        batch_input = stdin;
+    } else {
+        batch_input = fopen(script_file.c_str(), "r");
+    }
+
+    if (batch_input == nullptr) {
+        (void) printf("Can't open batch command file '%s'.\n", script_file.c_str());
+        return false;
+    }
+
+    terminalInitializeNullUI(batch_key_source);
+
+    return true;
+}
+
+// Run the game without a terminal, reading key presses from `source`.
+void terminalInitializeNullUI(KeySource_t const &source) {
+    batch_mode = true;
+    key_source = &source;
+}
+
+// Leave the null UI for the terminal, part way through a game. The screen
+// is drawn as it would be by now, had it been shown all along.
+bool terminalLeaveNullUI() {
+    if (!terminalInitialize()) {
+        return false;
+    }
+
+    batch_mode = false;
+    key_source = &terminal_key_source;
+
+    if (game.character_generated) {
+        drawCavePanel();
+    }
+
+    return true;
+}
+
+// Cuts a forked worker process off from the terminal and the batch script:
+// nothing it draws is shown, and any key press it waits for reads as the
+// end of input.
+void terminalDetach() {
+    terminalInitializeNullUI(detached_key_source);
+}
+
 // Put the terminal in the original mode. -CJS-
 void terminalRestore() {
     if (!curses_on) {
@@ -83,15 +263,33 @@ void terminalRestore() {
 }
 
 void terminalSaveScreen() {
+    if (batch_mode) {
+        return;
+    }
+
+    panelFlushTiles();
+    (void) memcpy(panel_saved_glyphs, panel_glyphs, sizeof(panel_glyphs));
+
     overwrite(stdscr, save_screen);
 }
 
 void terminalRestoreScreen() {
+    if (batch_mode) {
+        return;
+    }
+
+    panelFlushTiles();
+    (void) memcpy(panel_glyphs, panel_saved_glyphs, sizeof(panel_glyphs));
+
     overwrite(save_screen, stdscr);
     touchwin(stdscr);
 }
 
 ssize_t terminalBellSound() {
+    if (batch_mode) {
+        return 0;
+    }
+
     putQIO();
 
     // The player can turn off beeps if they find them annoying.
@@ -102,11 +300,70 @@ ssize_t terminalBellSound() {
     return 0;
 }
 
+// Show a projectile in flight: queue the tiles changed since the last frame
+// as the next frame of its animation. With the animate_projectiles option
+// off this does nothing, and the screen is only brought up to date when the
+// projectile has landed, so only where it ended up is ever drawn.
+void panelShowFrame() {
+    // Let inventoryExecuteCommand() know something has changed.
+    screen_has_changed = true;
+
+    if (batch_mode || !config::options::animate_projectiles || !panel_has_dirty_tiles) {
+        return;
+    }
+
+    int frame_start = panel_frames == 0 ? 0 : panel_frame_ends[panel_frames - 1];
+    int tiles = frame_start;
+
+    for (int row = 0; row < SCREEN_HEIGHT; row++) {
+        if (!panel_row_dirty[row]) {
+            continue;
+        }
+
+        for (int col = 0; col < SCREEN_WIDTH; col++) {
+            if (!panel_dirty[row][col]) {
+                continue;
+            }
+
+            if (tiles == PANEL_FRAME_TILES_MAX) {
+                // No room left, so play out the queue so far, along with
+                // the rest of this frame. A frame with no tiles taken yet is
+                // left off the queue, rather than played as an empty frame.
+                if (tiles > frame_start) {
+                    panel_frame_ends[panel_frames++] = tiles;
+                }
+                putQIO();
+                return;
+            }
+
+            panel_dirty[row][col] = false;
+            panel_frame_tiles[tiles++] = PanelFrameTile_t{(uint8_t) row, (uint8_t) col, panel_pending[row][col]};
+        }
+
+        panel_row_dirty[row] = false;
+    }
+
+    panel_has_dirty_tiles = false;
+    panel_frame_ends[panel_frames++] = tiles;
+
+    if (panel_frames == PANEL_FRAMES_MAX) {
+        putQIO();
+    }
+}
+
 // Dump the IO buffer to terminal -RAK-
 void putQIO() {
     // Let inventoryExecuteCommand() know something has changed.
     screen_has_changed = true;
 
+    if (batch_mode) {
+        return;
+    }
+
+    TURN_STATS_PHASE(TurnPhase::Drawing);
+
+    panelFlushTiles();
+
     (void) refresh();
 }
 
@@ -116,7 +373,7 @@ void flushInputBuffer() {
         return;
     }
 
-    while (checkForNonBlockingKeyPress(0))
+    while (checkForNonBlockingKeyPress())
         ;
 }
 
@@ -125,20 +382,51 @@ void clearScreen() {
     if (message_ready_to_print) {
         printMessage(CNIL);
     }
+
+    if (batch_mode) {
+        return;
+    }
+
+    panelFlushTiles();
+    for (int row = 0; row < SCREEN_HEIGHT; row++) {
+        panelSetScreenCells(Coord_t{row + PANEL_SCREEN_ROW, PANEL_SCREEN_COL}, SCREEN_WIDTH, ' ');
+    }
+
     (void) clear();
 }
 
 void clearToBottom(int row) {
+    if (batch_mode) {
+        return;
+    }
+
+    panelFlushTiles();
+    for (int y = row; y < PANEL_SCREEN_ROW + SCREEN_HEIGHT; y++) {
+        panelSetScreenCells(Coord_t{y, PANEL_SCREEN_COL}, SCREEN_WIDTH, ' ');
+    }
+
     (void) move(row, 0);
     clrtobot();
 }
 
 // move cursor to a given y, x position
 void moveCursor(Coord_t coord) {
+    if (batch_mode) {
+        return;
+    }
+
     (void) move(coord.y, coord.x);
 }
 
 void addChar(char ch, Coord_t coord) {
+    if (batch_mode) {
+        return;
+    }
+
+    panelFlushTiles();
+    panelSetScreenCells(coord, 1, 0);
+
+    TURN_STATS_COUNT(TurnCounter::CursesWrites);
     if (mvaddch(coord.y, coord.x, ch) == ERR) {
         abort();
     }
@@ -146,6 +434,10 @@ void addChar(char ch, Coord_t coord) {
 
 // Dump IO to buffer -RAK-
 void putString(const char *out_str, Coord_t coord) {
+    if (batch_mode) {
+        return;
+    }
+
     // truncate the string, to make sure that it won't go past right edge of screen.
     if (coord.x > 79) {
         coord.x = 79;
@@ -155,6 +447,10 @@ void putString(const char *out_str, Coord_t coord) {
     (void) strncpy(str, out_str, (size_t)(79 - coord.x));
     str[79 - coord.x] = '\0';
 
+    panelFlushTiles();
+    panelSetScreenCells(coord, (int) strlen(str), 0);
+
+    TURN_STATS_COUNT(TurnCounter::CursesWrites);
     if (mvaddstr(coord.y, coord.x, str) == ERR) {
         abort();
     }
@@ -166,6 +462,13 @@ void putStringClearToEOL(const std::string &str, Coord_t coord) {
         printMessage(CNIL);
     }
 
+    if (batch_mode) {
+        return;
+    }
+
+    panelFlushTiles();
+    panelSetScreenCells(coord, SCREEN_WIDTH, ' ');
+
     (void) move(coord.y, coord.x);
     clrtoeol();
     putString(str.c_str(), coord);
@@ -177,12 +480,23 @@ void eraseLine(Coord_t coord) {
         printMessage(CNIL);
     }
 
+    if (batch_mode) {
+        return;
+    }
+
+    panelFlushTiles();
+    panelSetScreenCells(coord, SCREEN_WIDTH, ' ');
+
     (void) move(coord.y, coord.x);
     clrtoeol();
 }
 
 // Moves the cursor to a given interpolated y, x position -RAK-
 void panelMoveCursor(Coord_t coord) {
+    if (batch_mode) {
+        return;
+    }
+
     // Real coords convert to screen positions
     coord.y -= dg.panel.row_prt;
     coord.x -= dg.panel.col_prt;
@@ -194,14 +508,34 @@ void panelMoveCursor(Coord_t coord) {
 
 // Outputs a char to a given interpolated y, x position -RAK-
 // sign bit of a character used to indicate standout mode. -CJS
+//
+// The tile is only drawn when the panel tiles are next flushed,
+// and then only if it differs from what is already on the screen.
 void panelPutTile(char ch, Coord_t coord) {
+    if (batch_mode) {
+        return;
+    }
+
     // Real coords convert to screen positions
     coord.y -= dg.panel.row_prt;
     coord.x -= dg.panel.col_prt;
 
-    if (mvaddch(coord.y, coord.x, ch) == ERR) {
-        abort();
+    int row = coord.y - PANEL_SCREEN_ROW;
+    int col = coord.x - PANEL_SCREEN_COL;
+
+    if (row < 0 || row >= SCREEN_HEIGHT || col < 0 || col >= SCREEN_WIDTH) {
+        panelFlushTiles();
+
+        if (mvaddch(coord.y, coord.x, ch) == ERR) {
+            abort();
+        }
+        return;
     }
+
+    panel_pending[row][col] = ch;
+    panel_dirty[row][col] = true;
+    panel_row_dirty[row] = true;
+    panel_has_dirty_tiles = true;
 }
 
 static Coord_t currentCursorPosition() {
@@ -213,6 +547,10 @@ static Coord_t currentCursorPosition() {
 // messageLinePrintMessage will print a line of text to the message line (0,0).
 // first clearing the line of any text!
 void messageLinePrintMessage(std::string message) {
+    if (batch_mode) {
+        return;
+    }
+
     // save current cursor position
     Coord_t coord = currentCursorPosition();
 
@@ -223,6 +561,7 @@ void messageLinePrintMessage(std::string message) {
     // truncate message if it's too long!
     message.resize(79);
 
+    TURN_STATS_COUNT(TurnCounter::CursesWrites);
     addstr(message.c_str());
 
     // restore cursor to old position
@@ -232,6 +571,10 @@ void messageLinePrintMessage(std::string message) {
 // deleteMessageLine will delete all text from the message line (0,0).
 // The current cursor position will be maintained.
 void messageLineClear() {
+    if (batch_mode) {
+        return;
+    }
+
     // save current cursor position
     Coord_t coord = currentCursorPosition();
 
@@ -243,15 +586,18 @@ void messageLineClear() {
     move(coord.y, coord.x);
 }
 
-// Outputs message to top line of screen
-// These messages are kept for later reference.
-void printMessage(const char *msg) {
+// Outputs message to top line of screen, and keeps it in the message
+// history, along with where it came from, and its format and parameters,
+// when it was made from one.
+static void messageLinePrint(const char *msg, MessageSource source, const char *format, int32_t const params[MESSAGE_PARAMS_MAX]) {
     int new_len = 0;
     int old_len = 0;
     bool combine_messages = false;
 
-    if (message_ready_to_print) {
-        old_len = (int) strlen(messages[last_message_id]) + 1;
+    if (message_ready_to_print && key_source->is_script) {
+        // there is no one to read a -more- prompt, so just move on to the next message.
+    } else if (message_ready_to_print) {
+        old_len = messageHistoryNewestLength() + 1;
 
         // If the new message and the old message are short enough,
         // we want display them together on the same line.  So we
@@ -280,7 +626,7 @@ void printMessage(const char *msg) {
         }
     }
 
-    if (!combine_messages) {
+    if (!combine_messages && !batch_mode) {
         (void) move(MSG_LINE, 0);
         clrtoeol();
     }
@@ -300,19 +646,41 @@ void printMessage(const char *msg) {
 
     if (combine_messages) {
         putString(msg, Coord_t{MSG_LINE, old_len + 2});
-        strcat(messages[last_message_id], "  ");
-        strcat(messages[last_message_id], msg);
+        messageHistoryAppend(msg);
     } else {
-        messageLinePrintMessage(msg);
-        last_message_id++;
-
-        if (last_message_id >= MESSAGE_HISTORY_SIZE) {
-            last_message_id = 0;
+        if (!batch_mode) {
+            messageLinePrintMessage(msg);
         }
+        messageHistoryAddFormat(source, format, params, msg);
+    }
+}
+
+// Outputs message to top line of screen
+// These messages are kept for later reference.
+void printMessage(const char *msg) {
+    messageLinePrint(msg, MessageSource::General, nullptr, nullptr);
+}
+
+// Outputs the message messageFormat() makes from `format` and the
+// parameters. While the keys come from a batch script nothing looks at the
+// message line, so the text is not made at all: the message only goes into
+// the message history, to be made when it is read from there.
+void printMessageFormat(MessageSource source, const char *format, int32_t first, int32_t second) {
+    int32_t params[MESSAGE_PARAMS_MAX] = {first, second};
+
+    if (batch_mode && key_source->is_script) {
+        // all that messageLinePrint() does in batch mode
+        game.command_count = 0;
+        message_ready_to_print = true;
 
-        (void) strncpy(messages[last_message_id], msg, MORIA_MESSAGE_SIZE);
-        messages[last_message_id][MORIA_MESSAGE_SIZE - 1] = '\0';
+        messageHistoryAddFormat(source, format, params, nullptr);
+        return;
     }
+
+    vtype_t msg = {'\0'};
+    messageFormat(format, params, msg);
+
+    messageLinePrint(msg, source, format, params);
 }
 
 // Print a message so as not to interrupt a counted command. -CJS-
@@ -326,6 +694,30 @@ void printMessageNoCommandInterrupt(const std::string &msg) {
     game.command_count = i;
 }
 
+static int terminalReadKey() {
+    return getch();
+}
+
+static int batchReadKey() {
+    return getc(batch_input);
+}
+
+static int detachedReadKey() {
+    return EOF;
+}
+
+// Read the next raw key press from the key source.
+static int readKeyPress() {
+    TURN_STATS_PHASE(TurnPhase::KeyWait);
+
+    int ch;
+    do {
+        ch = key_source->readKey();
+    } while (ch == KEY_SOURCE_CHANGED);
+
+    return ch;
+}
+
 // Returns a single character input from the terminal. -CJS-
 //
 // This silently consumes ^R to redraw the screen and reset the
@@ -336,7 +728,7 @@ char getKeyInput() {
     game.command_count = 0; // Just to be safe -CJS-
 
     while (true) {
-        int ch = getch();
+        int ch = readKeyPress();
 
         // some machines may not sign extend.
         if (ch == EOF) {
@@ -345,7 +737,9 @@ char getKeyInput() {
 
             eof_flag++;
 
-            (void) refresh();
+            if (!batch_mode) {
+                (void) refresh();
+            }
 
             if (!game.character_generated || game.character_saved) {
                 endGame();
@@ -368,9 +762,14 @@ char getKeyInput() {
         }
 
         if (ch != CTRL_KEY('R')) {
+            replayRecordKey((char) ch);
             return (char) ch;
         }
 
+        if (batch_mode) {
+            continue;
+        }
+
         (void) wrefresh(curscr);
         moriaTerminalInitialize();
     }
@@ -392,13 +791,18 @@ bool getCommand(const std::string &prompt, char &command) {
 // Gets a string terminated by <RETURN>
 // Function returns false if <ESCAPE> is input
 bool getStringInput(char *in_str, Coord_t coord, int slen) {
-    (void) move(coord.y, coord.x);
+    if (!batch_mode) {
+        panelFlushTiles();
+        panelSetScreenCells(coord, slen, 0);
 
-    for (int i = slen; i > 0; i--) {
-        (void) addch(' ');
-    }
+        (void) move(coord.y, coord.x);
 
-    (void) move(coord.y, coord.x);
+        for (int i = slen; i > 0; i--) {
+            (void) addch(' ');
+        }
+
+        (void) move(coord.y, coord.x);
+    }
 
     int start_col = coord.x;
     int end_col = coord.x + slen - 1;
@@ -435,7 +839,9 @@ bool getStringInput(char *in_str, Coord_t coord, int slen) {
                 if ((isprint(key) == 0) || coord.x > end_col) {
                     terminalBellSound();
                 } else {
-                    mvaddch(coord.y, coord.x, (char) key);
+                    if (!batch_mode) {
+                        mvaddch(coord.y, coord.x, (char) key);
+                    }
                     *p++ = (char) key;
                     coord.x++;
                 }
@@ -460,16 +866,18 @@ bool getStringInput(char *in_str, Coord_t coord, int slen) {
 bool getInputConfirmation(const std::string &prompt) {
     putStringClearToEOL(prompt, Coord_t{0, 0});
 
-    int y, x;
-    getyx(stdscr, y, x);
+    if (!batch_mode) {
+        int y, x;
+        getyx(stdscr, y, x);
 
-    if (x > 73) {
-        (void) move(0, 73);
-    } else if (y != 0) {
-        // use `y` to prevent compiler warning.
-    }
+        if (x > 73) {
+            (void) move(0, 73);
+        } else if (y != 0) {
+            // use `y` to prevent compiler warning.
+        }
 
-    (void) addstr(" [y/n]");
+        (void) addstr(" [y/n]");
+    }
 
     char input = ' ';
     while (input == ' ') {
@@ -488,41 +896,42 @@ void waitForContinueKey(int line_number) {
     eraseLine(Coord_t{line_number, 0});
 }
 
-// Provides for a timeout on input. Does a non-blocking read, consuming the data if
-// any, and then returns 1 if data was read, zero otherwise.
-//
-// Porting:
+// Does a non-blocking read, consuming the data if any, and then returns
+// true if data was read, false otherwise.
 //
-// In systems without the select call, but with a sleep for fractional numbers of
-// seconds, one could sleep for the time and then check for input.
-//
-// In systems which can only sleep for whole number of seconds, you might sleep by
-// writing a lot of nulls to the terminal, and waiting for them to drain, or you
-// might hack a static accumulation of times to wait. When the accumulation reaches
-// a certain point, sleep for a second. There would need to be a way of resetting
-// the count, with a call made for commands like run or rest.
-bool checkForNonBlockingKeyPress(int microseconds) {
-#ifdef _WIN32
-    (void) microseconds;
+// The poll never waits for input: resting, running and repeated commands
+// call this from the main game loop, and any delay here is paid on every
+// game turn.
+bool checkForNonBlockingKeyPress() {
+    bool pressed = key_source->keyPressWaiting();
+    replayRecordKeyPressWaiting(pressed);
+    return pressed;
+}
 
+// In batch mode the command script is never treated as an interrupt,
+// otherwise a rest or run would swallow the next scripted command.
+static bool batchKeyPressWaiting() {
+    return false;
+}
+
+static bool terminalKeyPressWaiting() {
+#ifdef _WIN32
     // Ugly non-blocking read...Ugh! -MRC-
-    timeout(8);
+    timeout(0);
     int result = getch();
     timeout(-1);
 
     return result > 0;
 #else
     struct timeval tbuf {};
-    int ch;
-    int smask;
+    fd_set input_fds;
 
-    // Return true if a read on descriptor 1 will not block.
-    tbuf.tv_sec = 0;
-    tbuf.tv_usec = microseconds;
+    // Return true if a read on stdin will not block.
+    FD_ZERO(&input_fds);
+    FD_SET(STDIN_FILENO, &input_fds);
 
-    smask = 1; // i.e. (1 << 0)
-    if (select(1, (fd_set *) &smask, (fd_set *) nullptr, (fd_set *) nullptr, &tbuf) == 1) {
-        ch = getch();
+    if (select(STDIN_FILENO + 1, &input_fds, nullptr, nullptr, &tbuf) == 1) {
+        int ch = getch();
         // check for EOF errors here, select sometimes works even when EOF
         if (ch == -1) {
             eof_flag++;
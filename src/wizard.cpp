@@ -556,7 +556,7 @@ void wizardCreateObjects() {
 
     if (getInputConfirmation("Allocate?")) {
         // delete object first if any, before call popt()
-        Tile_t &tile = dg.floor[py.pos.y][py.pos.x];
+        Tile_t tile = dg.floor[py.pos.y][py.pos.x];
 
         if (tile.treasure_id != 0) {
             (void) dungeonDeleteObject(py.pos);